@@ -0,0 +1,47 @@
+// Generalized Galois LFSR (right-shifting, as in dut_110/dut_112) with a
+// loadable seed and leap-forward output: every clock performs K steps and
+// reports the K bits shifted out of q[0], oldest step in bits[0].
+// The WIDTH/TAPS defaults are dut_112's register (taps 32/22/2/1); it steps
+// like dut_112 only with K overridden to 1 (PARAMS="K=1"), K defaults to 8.
+// A zero seed locks the register at zero.
+module top_module #(
+    parameter WIDTH = 32,
+    parameter [WIDTH-1:0] TAPS = 32'h80200003,
+    parameter K = 8
+)(
+    input clk,
+    input reset,
+    input load,
+    input [WIDTH-1:0] seed,
+    output reg [WIDTH-1:0] q,
+    output reg [K-1:0] bits
+);
+
+    reg [WIDTH-1:0] q_next;
+    reg [K-1:0] bits_next;
+
+    integer i;
+    always @(*) begin
+        q_next = q;
+        for (i = 0; i < K; i = i + 1) begin
+            bits_next[i] = q_next[0];
+            q_next = (q_next >> 1) ^ (q_next[0] ? TAPS : {WIDTH{1'b0}});
+        end
+    end
+
+    always @(posedge clk) begin
+        if (reset) begin
+            q <= {{(WIDTH-1){1'b0}}, 1'b1};
+            bits <= {K{1'b0}};
+        end
+        else if (load) begin
+            q <= seed;
+            bits <= {K{1'b0}};
+        end
+        else begin
+            q <= q_next;
+            bits <= bits_next;
+        end
+    end
+
+endmodule
@@ -0,0 +1,25 @@
+module top_module(
+    input  [99:0] a, b,
+    input         cin,
+    output reg [99:0] cout,
+    output reg [99:0] sum
+    );
+
+    // Kogge-Stone parallel-prefix variant of dut_042 (same ports).
+    // cin is folded into the generate bit of position 0, then each level
+    // combines (g, p) pairs at distance 1, 2, 4, ..., 64: 7 word-wide levels
+    // instead of a 100-deep carry chain. Afterwards g[i] is the carry out of bit i.
+    integer d;
+    reg [99:0] g, p;
+    always @* begin
+        p = a ^ b;
+        g = (a & b) | {99'b0, p[0] & cin};
+        for (d = 1; d < 100; d = d << 1) begin
+            g = g | (p & (g << d));
+            p = p & (p << d);
+        end
+        cout = g;
+        sum  = a ^ b ^ {g[98:0], cin};
+    end
+
+endmodule
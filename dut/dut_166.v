@@ -0,0 +1,21 @@
+module top_module( 
+    input [254:0] in,
+    output [7:0] out 
+   );
+
+    // Adder-tree variant of dut_041 (same ports). Each level adds
+    // neighbouring fields in parallel (2-bit, 4-bit, ... 256-bit sums), so the
+    // 255 dependent increments become 8 word-wide masked adds.
+    wire [255:0] l0 = {1'b0, in};
+    wire [255:0] l1 = (l0 & {128{2'h1}}) + ((l0 >> 1) & {128{2'h1}});
+    wire [255:0] l2 = (l1 & {64{4'h3}}) + ((l1 >> 2) & {64{4'h3}});
+    wire [255:0] l3 = (l2 & {32{8'h0F}}) + ((l2 >> 4) & {32{8'h0F}});
+    wire [255:0] l4 = (l3 & {16{16'h00FF}}) + ((l3 >> 8) & {16{16'h00FF}});
+    wire [255:0] l5 = (l4 & {8{32'h0000FFFF}}) + ((l4 >> 16) & {8{32'h0000FFFF}});
+    wire [255:0] l6 = (l5 & {4{64'h00000000FFFFFFFF}}) + ((l5 >> 32) & {4{64'h00000000FFFFFFFF}});
+    wire [127:0] l7 = l6[127:0] + l6[255:128];
+    wire [63:0]  l8 = l7[63:0] + l7[127:64];
+
+    assign out = l8[7:0];
+
+endmodule
@@ -0,0 +1,46 @@
+module top_module #(
+    parameter W = 8
+)(
+    input clk,
+    input reset,    // Synchronous reset
+    input [W-1:0] in,   // in[0] is the earliest bit on the line
+    output reg [W-1:0] disc,
+    output reg [W-1:0] flag,
+    output reg [W-1:0] err
+  );
+
+	// Word-parallel version of dut_138 taking W line bits per clock.
+	// The serial NONE..SIX and ERR states are a saturating count of
+	// consecutive ones (7 = ERR); DISC and FLAG are the zero that ends a run
+	// of five or six ones. disc/flag/err[i] equal the serial outputs after
+	// bit i, so the masks match dut_138 bit for bit.
+	reg [2:0] ones, ones_next;
+	reg [W-1:0] disc_next, flag_next, err_next;
+
+	integer i;
+	always @(*) begin
+		ones_next = ones;
+		for (i = 0; i < W; i = i + 1) begin
+			disc_next[i] = ~in[i] & (ones_next == 3'd5);
+			flag_next[i] = ~in[i] & (ones_next == 3'd6);
+			ones_next = in[i] ? ((ones_next == 3'd7) ? 3'd7 : ones_next + 3'd1) : 3'd0;
+			err_next[i] = (ones_next == 3'd7);
+		end
+	end
+
+	always @(posedge clk) begin
+		if (reset) begin
+			ones <= 3'd0;
+			disc <= {W{1'b0}};
+			flag <= {W{1'b0}};
+			err  <= {W{1'b0}};
+		end
+		else begin
+			ones <= ones_next;
+			disc <= disc_next;
+			flag <= flag_next;
+			err  <= err_next;
+		end
+	end
+
+endmodule
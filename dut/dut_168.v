@@ -0,0 +1,133 @@
+module top_module #(
+    parameter N = 8
+)(
+    input clk,
+    input reset,    // Synchronous reset
+    input [N-1:0] in,
+    output [8*N-1:0] out_byte,
+    output [N-1:0] done
+);
+
+    // Bank of N independent serial receivers with odd parity (dut_137),
+    // one per line in[l]; lane l reports on out_byte[8*l +: 8] and done[l].
+    generate
+        genvar l;
+        for (l = 0; l < N; l = l + 1)
+        begin : lane
+            serial_rx_parity u_rx(
+                .clk(clk),
+                .in(in[l]),
+                .reset(reset),
+                .out_byte(out_byte[8*l +: 8]),
+                .done(done[l])
+            );
+        end
+    endgenerate
+
+endmodule
+
+// One lane of the bank: dut_137's receiver. The FSM frames start bit, 8
+// data bits, parity and stop bit; done pulses for a frame with odd parity.
+module serial_rx_parity(
+    input clk,
+    input in,
+    input reset,    // Synchronous reset
+    output [7:0] out_byte,
+    output done
+); 
+	
+    // Frame FSM; CHECK samples the stop bit after the parity bit.
+    localparam [2:0] IDLE 	 = 3'b000,
+					 START 	 = 3'b001,
+					 RECEIVE = 3'b010,
+					 WAIT	 = 3'b011,
+					 STOP    = 3'b100,
+					 CHECK   = 3'b101;
+
+	reg [2:0] state, next;
+	reg [3:0] i;
+	reg [7:0] out;
+	reg odd_reset;
+	reg odd_reg;
+	wire odd;	
+	
+
+	always @(*) begin
+		case(state)
+			IDLE  	: next = (in) ? IDLE : START;
+			START 	: next = RECEIVE;
+			RECEIVE : next = (i == 8) ? CHECK : RECEIVE;
+			CHECK 	: next = (in) ? STOP : WAIT;
+			WAIT 	: next = (in) ? IDLE : WAIT;
+			STOP 	: next = (in) ? IDLE : START;
+		endcase
+	end
+
+	always @(posedge clk) begin
+		if(reset) state <= IDLE;
+		else state <= next;
+	end
+
+	always @(posedge clk) begin
+		if (reset) begin
+			i <= 0;
+		end
+		else begin
+			case(next) 
+				RECEIVE : begin
+					i <= i + 4'h1;
+				end
+				STOP : begin
+					i <= 0;
+				end
+				default : begin
+					i <= 0;
+				end
+			endcase
+		end
+	end
+
+    // Data bits, LSB first, into this lane's byte register.
+    always @(posedge clk) begin
+    	if (reset) out <= 0;
+    	else if (next == RECEIVE)
+    		out[i] <= in;
+    end
+
+    // Running parity over data and parity bits, cleared between frames.
+    parity u_parity(
+        .clk(clk),
+        .reset(reset | odd_reset),
+        .in(in),
+        .odd(odd));  
+
+    always @(posedge clk) begin
+    	if(reset) odd_reg <= 0;
+    	else odd_reg <= odd; 
+    end
+
+    always @(posedge clk) begin
+		case(next)
+			IDLE : odd_reset <= 1;	
+			STOP : odd_reset <= 1;
+			default : odd_reset <= 0;
+		endcase
+    end
+
+    assign done = ((state == STOP) && odd_reg);
+    assign out_byte = (done) ? out : 8'b0;
+
+endmodule
+
+// Simple odd-parity generator over serial input stream.
+module parity(
+    input clk,
+    input reset,
+    input in,
+    output reg odd
+);
+    always @(posedge clk) begin
+        if (reset) odd <= 0;
+        else odd <= odd ^ in;
+    end
+endmodule
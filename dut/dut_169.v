@@ -0,0 +1,71 @@
+module top_module #(
+    parameter B = 8,                    // bytes accepted per clock
+    localparam P = (B + 2) / 3          // most packets that can finish in one word
+)(
+    input clk,
+    input [8*B-1:0] in,                 // in[7:0] is the earliest byte
+    input [B-1:0] valid,
+    input reset,    // Synchronous reset
+    output reg [24*P-1:0] out_bytes,    // packet k on out_bytes[24*k +: 24]
+    output reg [P-1:0] done);           // done[k]: packet k finished this word
+
+    // Multi-byte version of dut_134. Valid bytes are framed in order exactly
+    // as the serial FSM would see them: hunt for a byte with in[3] set, take
+    // two more, emit {byte1, byte2, byte3}. phase/part carry a partial packet
+    // into the next word; finished packets fill slots 0, 1, ... in order.
+    localparam [1:0] HUNT  = 2'd0,
+    				 HAVE1 = 2'd1,
+    				 HAVE2 = 2'd2;
+
+    reg [1:0] phase, phase_next;
+    reg [15:0] part, part_next;
+    reg [24*P-1:0] out_next;
+    reg [P-1:0] done_next;
+    reg [7:0] b;
+
+    integer i, n;
+    always @(*) begin
+    	phase_next = phase;
+    	part_next = part;
+    	out_next = {24*P{1'b0}};
+    	done_next = {P{1'b0}};
+    	n = 0;
+    	for (i = 0; i < B; i = i + 1) begin
+    		b = in[8*i +: 8];
+    		if (valid[i]) begin
+    			case (phase_next)
+    				HUNT : if (b[3]) begin
+    					part_next[15:8] = b;
+    					phase_next = HAVE1;
+    				end
+    				HAVE1 : begin
+    					part_next[7:0] = b;
+    					phase_next = HAVE2;
+    				end
+    				default : begin
+    					out_next[24*n +: 24] = {part_next, b};
+    					done_next[n] = 1'b1;
+    					n = n + 1;
+    					phase_next = HUNT;
+    				end
+    			endcase
+    		end
+    	end
+    end
+
+    always @(posedge clk) begin
+    	if (reset) begin
+    		phase <= HUNT;
+    		part <= 16'b0;
+    		out_bytes <= {24*P{1'b0}};
+    		done <= {P{1'b0}};
+    	end
+    	else begin
+    		phase <= phase_next;
+    		part <= part_next;
+    		out_bytes <= out_next;
+    		done <= done_next;
+    	end
+    end
+
+endmodule
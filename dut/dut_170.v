@@ -0,0 +1,46 @@
+module top_module #(
+    parameter W = 8,                        // bits accepted per clock
+    localparam PW = (W > 1) ? $clog2(W) : 1
+)(
+    input clk,
+    input reset,      // Synchronous reset
+    input [W-1:0] data,                     // data[0] is the earliest bit
+    output reg start_shifting,
+    output reg match,                       // first 1101 completed in this word
+    output reg [PW-1:0] pos);               // data bit that completed it
+
+    // Word-rate version of dut_154. The last three bits of the previous word
+    // are kept in hist, so a 1101 that straddles a word boundary is seen.
+    // Every window position is tested at once; the lowest one is the first
+    // match in time. start_shifting latches as in dut_154, and pos keeps the
+    // position of the first match until reset.
+    reg [2:0] hist;             // hist[2] is the most recent bit
+    wire [W+2:0] win = {data, hist};
+    // hit[i]: win[i+3:i] read oldest first is 1,1,0,1, ending at data[i]
+    wire [W-1:0] hit = win[W+2:3] & ~win[W+1:2] & win[W:1] & win[W-1:0];
+
+    reg [PW-1:0] first;
+    integer i;
+    always @(*) begin
+    	first = {PW{1'b0}};
+    	for (i = W - 1; i >= 0; i = i - 1)
+    		if (hit[i]) first = i[PW-1:0];
+    end
+
+    always @(posedge clk) begin
+    	if (reset) begin
+    		hist <= 3'b000;
+    		start_shifting <= 1'b0;
+    		match <= 1'b0;
+    		pos <= {PW{1'b0}};
+    	end
+    	else begin
+    		hist <= win[W+2:W];
+    		match <= (|hit) & ~start_shifting;
+    		if ((|hit) & ~start_shifting) begin
+    			start_shifting <= 1'b1;
+    			pos <= first;
+    		end
+    	end
+    end
+endmodule
@@ -0,0 +1,75 @@
+module top_module #(
+    parameter HIST_BITS = 7,            // global history length, 2..PHT_BITS
+    parameter PHT_BITS = 7              // log2 of the number of 2-bit counters
+)(
+    input clk,
+    input areset,
+
+    input  predict_valid,
+    input  [PHT_BITS-1:0] predict_pc,
+    output reg predict_taken,
+    output reg [HIST_BITS-1:0] predict_history,
+
+    input train_valid,
+    input train_taken,
+    input train_mispredicted,
+    input [HIST_BITS-1:0] train_history,
+    input [PHT_BITS-1:0] train_pc
+);
+
+    // dut_162 with the table geometry as parameters; the defaults give the
+    // same 7-bit history, 128-entry predictor. A history shorter than the
+    // index is zero-extended before the XOR with the pc.
+    localparam SNT = 2'd0, WNT = 2'd1, WT = 2'd2, ST = 2'd3;
+    localparam ENTRIES = 1 << PHT_BITS;
+
+    reg [1:0] PHT [0:ENTRIES-1];
+    reg [HIST_BITS-1:0] GHR;
+
+    reg [PHT_BITS-1:0] ghr_ext, train_history_ext;
+    always @(*) begin
+        ghr_ext = {PHT_BITS{1'b0}};
+        ghr_ext[HIST_BITS-1:0] = GHR;
+        train_history_ext = {PHT_BITS{1'b0}};
+        train_history_ext[HIST_BITS-1:0] = train_history;
+    end
+
+    wire [PHT_BITS-1:0] predict_index = predict_pc ^ ghr_ext;
+
+    always @(*) begin
+        if(predict_valid) begin
+            predict_taken = (PHT[predict_index] >= WT);
+            predict_history = GHR;
+        end else begin
+            predict_taken = 1'b0;
+            predict_history = {HIST_BITS{1'b0}};
+        end
+    end
+
+    wire [PHT_BITS-1:0] train_index = train_pc ^ train_history_ext;
+
+    integer i;
+    always @(posedge clk or posedge areset) begin
+        if(areset) begin
+            GHR <= {HIST_BITS{1'b0}};
+            for(i = 0; i < ENTRIES; i = i+1)
+                PHT[i] <= WNT;
+        end
+        else begin
+            if(train_valid) begin
+                case(PHT[train_index])
+                    SNT: PHT[train_index] <= train_taken ? WNT : SNT;
+                    WNT: PHT[train_index] <= train_taken ? WT : SNT;
+                    WT:  PHT[train_index] <= train_taken ? ST : WNT;
+                    ST:  PHT[train_index] <= train_taken ? ST : WT;
+                endcase
+            end
+            if (train_valid && train_mispredicted) begin
+                GHR <= {train_history[HIST_BITS-2:0], train_taken};
+            end else if (predict_valid) begin
+                GHR <= {GHR[HIST_BITS-2:0], predict_taken};
+            end
+        end
+    end
+
+endmodule
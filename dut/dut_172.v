@@ -0,0 +1,53 @@
+module top_module #(
+    parameter N = 3,                // requesters, 2..64
+    parameter ROUND_ROBIN = 0       // 0: fixed priority, r[1] highest; 1: round robin
+)(
+    input clk,
+    input resetn,    // active-low synchronous reset
+    input [N:1] r,   // request
+    output [N:1] g   // grant
+  );
+
+    // dut_150 at N requesters. The state register is the grant itself:
+    // zero is state a, bit i is the state granting requester i. From a the
+    // arbiter grants one requester on the next edge, holds the grant while
+    // its request stays high and goes back to a when it drops. With the
+    // defaults it is dut_150.
+    //
+    // The pick is one lowest-set-bit select on the requests. Round robin
+    // first masks off the requesters at and below the last grant, so the
+    // search starts just above it and wraps to r[1] when nothing above is
+    // requesting.
+    localparam [N:1] ONE = 1;
+
+    reg [N:1] state, next_state;
+    reg [N:1] last;                 // last grant, one-hot; 0 after reset
+
+    wire [N:1] above = ~((last << 1) - ONE);
+    wire [N:1] pool = (ROUND_ROBIN != 0 && (r & above) != 0) ? (r & above) : r;
+    wire [N:1] pick = pool & (~pool + ONE);
+
+    always@(*) begin
+        if(state == 0)
+            next_state = pick;
+        else if((state & r) != 0)
+            next_state = state;
+        else
+            next_state = 0;
+    end
+
+    always@(posedge clk) begin
+        if(~resetn) begin
+            state <= 0;
+            last <= 0;
+        end
+        else begin
+            state <= next_state;
+            if(next_state != 0)
+                last <= next_state;
+        end
+    end
+
+    assign g = state;
+
+endmodule
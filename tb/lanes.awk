@@ -0,0 +1,100 @@
+# Lane-packed wrapper for a DUT whose ports are all 1 bit wide, used by
+# `make DUT=<n> LANES=<k>`. Prints module lanes_top, which instantiates k
+# (1..64) copies of top_module and packs port p of copy i into bit i of a
+# k-bit port p, so one eval() advances k independent stimulus streams.
+# `clk` stays a single input shared by every lane.
+#
+#   awk -v lanes=64 -f tb/lanes.awk dut/dut_147.v > lanes_147.v
+
+function fail(msg) {
+    print "lanes.awk: " FILENAME ": " msg > "/dev/stderr"
+    failed = 1
+    exit 1
+}
+
+{
+    sub(/\r$/, "")
+    sub(/\/\/.*/, "")
+    text = text " " $0
+}
+
+END {
+    if (failed) {
+        exit 1
+    }
+    if (lanes < 1 || lanes > 64) {
+        fail("lanes must be 1..64")
+    }
+    gsub(/\/\*([^*]|\*+[^*\/])*\*+\//, " ", text)
+    if (!match(text, /module[ \t]+top_module[ \t]*\(/)) {
+        fail("no ANSI port list for top_module")
+    }
+    rest = substr(text, RSTART + RLENGTH)
+    list = substr(rest, 1, index(rest, ")") - 1)
+
+    n = split(list, items, ",")
+    count = 0
+    dir = ""
+    for (i = 1; i <= n; i++) {
+        if (items[i] ~ /\[/) {
+            fail("port wider than 1 bit:" items[i])
+        }
+        m = split(items[i], words, /[ \t\r\n]+/)
+        name = ""
+        for (j = 1; j <= m; j++) {
+            if (words[j] == "input" || words[j] == "output") {
+                dir = words[j]
+            } else if (words[j] == "inout") {
+                fail("inout ports are not supported")
+            } else if (words[j] != "" && words[j] != "reg" && words[j] != "wire" && words[j] != "logic") {
+                name = words[j]
+            }
+        }
+        if (name == "") {
+            if (n == 1 && items[i] !~ /[^ \t\r\n]/) {
+                continue    # empty port list
+            }
+            fail("port with no name:" items[i])
+        }
+        if (name !~ /^[A-Za-z_][A-Za-z0-9_$]*$/) {
+            fail("bad port name '" name "'")
+        }
+        if (dir == "") {
+            fail("port " name " has no direction")
+        }
+        count++
+        port[count] = name
+        pdir[count] = dir
+    }
+
+    print "// Generated by tb/lanes.awk from " FILENAME ": " lanes " lanes of top_module,"
+    print "// bit i of every port belongs to lane i; clk is shared."
+    print "module lanes_top ("
+    for (i = 1; i <= count; i++) {
+        sep = (i < count) ? "," : ""
+        if (port[i] == "clk") {
+            print "    input wire clk" sep
+        } else {
+            print "    " pdir[i] " wire [" lanes - 1 ":0] " port[i] sep
+        }
+    }
+    print ");"
+    print ""
+    print "    genvar i;"
+    print "    generate"
+    print "        for (i = 0; i < " lanes "; i = i + 1) begin : lane"
+    print "            top_module u_dut ("
+    for (i = 1; i <= count; i++) {
+        sep = (i < count) ? "," : ""
+        if (port[i] == "clk") {
+            print "                .clk(clk)" sep
+        } else {
+            print "                ." port[i] "(" port[i] "[i])" sep
+        }
+    }
+    print "            );"
+    print "        end"
+    print "    endgenerate"
+    print ""
+    print "endmodule"
+}
@@ -0,0 +1,93 @@
+#ifndef BCD_SWAR_H
+#define BCD_SWAR_H
+
+// Packed-BCD reference adder working on 64-bit words, 16 digits at a time.
+// Each digit is pre-biased by +6 so a binary add carries out of exactly the
+// digits whose decimal sum is >= 10; the bias is then removed from the
+// digits that did not carry. Used by the 400-bit BCD adder testbenches,
+// together with the helpers below for their 400-bit ports.
+
+#include <cstdint>
+#include <random>
+
+namespace tb
+{
+    // 0x111...1 with `digits` nibbles set (digits <= 16).
+    inline uint64_t bcd_ones(unsigned digits)
+    {
+        return digits >= 16U ? 0x1111111111111111ULL
+                             : (0x1111111111111111ULL & ((1ULL << (4U * digits)) - 1ULL));
+    }
+
+    // Adds the low `digits` BCD digits of a and b plus carry_in; digits must
+    // hold 0..9. Returns the BCD sum and updates carry_in to the carry out.
+    inline uint64_t bcd_add_word(uint64_t a, uint64_t b, unsigned &carry, unsigned digits = 16U)
+    {
+        const uint64_t ones = bcd_ones(digits);
+        const uint64_t t1 = a + ones * 6U;  // cannot overflow: each digit <= 15
+        uint64_t t2 = t1 + b;
+        unsigned c = t2 < t1 ? 1U : 0U;
+        const uint64_t t2c = t2 + carry;
+        c |= t2c < t2 ? 1U : 0U;
+        t2 = t2c;
+        if (digits < 16U)
+        {
+            c = static_cast<unsigned>(t2 >> (4U * digits)) & 1U;
+            t2 &= (1ULL << (4U * digits)) - 1ULL;
+        }
+        // Carry into each bit position; bit 4(d+1) is digit d's carry out.
+        const uint64_t carries = t2 ^ t1 ^ b;
+        const uint64_t carried = ((carries >> 4U) & ones) | (static_cast<uint64_t>(c) << (4U * (digits - 1U)));
+        const uint64_t uncarried = ones & ~carried;
+        carry = c;
+        return t2 - ((uncarried << 2U) | (uncarried << 1U));
+    }
+
+    // Multi-word add over little-endian 64-bit words holding `digits` digits.
+    inline unsigned bcd_add(const uint64_t *a, const uint64_t *b, uint64_t *sum, unsigned digits,
+                            unsigned carry)
+    {
+        for (unsigned w = 0; digits != 0U; ++w)
+        {
+            const unsigned n = digits < 16U ? digits : 16U;
+            sum[w] = bcd_add_word(a[w], b[w], carry, n);
+            digits -= n;
+        }
+        return carry;
+    }
+
+    // 100 packed BCD digits as 7 little-endian 64-bit words (6x16 + 4
+    // digits), to and from a 400-bit port (13 x 32-bit words).
+    inline void put_400(uint32_t w[13], const uint64_t d[7])
+    {
+        for (int i = 0; i < 13; ++i)
+        {
+            w[i] = static_cast<uint32_t>(d[i >> 1] >> (32 * (i & 1)));
+        }
+    }
+
+    inline bool eq_400(const uint32_t w[13], const uint64_t d[7])
+    {
+        for (int i = 0; i < 13; ++i)
+        {
+            if (w[i] != static_cast<uint32_t>(d[i >> 1] >> (32 * (i & 1))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // `digits` uniform random BCD digits in the low nibbles.
+    inline uint64_t rand_bcd_word(std::mt19937_64 &rng, unsigned digits)
+    {
+        uint64_t w = 0;
+        for (unsigned d = 0; d < digits; ++d)
+        {
+            w |= ((((rng() & 0xFFFFu) * 10u) >> 16) & 0xFu) << (4 * d);
+        }
+        return w;
+    }
+}
+
+#endif
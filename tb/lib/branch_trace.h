@@ -0,0 +1,311 @@
+#ifndef BRANCH_TRACE_H
+#define BRANCH_TRACE_H
+
+// Branch traces for the predictor testbenches (dut_162 and variants).
+//
+// On disk a trace is a flat array of little-endian BranchRecord, 8 bytes
+// each: the branch address and its resolved direction in bit 0 of `taken`.
+// Predictors index with the word address (pc >> 2), as the PC of a 32-bit
+// instruction set has two zero low bits.
+//
+// A trace comes from +trace=<path> (mmap'd), or is generated with
+// +branches=<n> records by a small synthetic program so that the replay
+// runs offline. +gen_trace=<path> writes the generated trace to a file for
+// reuse with other builds.
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "verilated.h"
+#include "mapped_file.h"
+#include "tb_harness.h"
+
+namespace tb
+{
+    struct BranchRecord
+    {
+        uint32_t pc;
+        uint32_t taken;
+    };
+
+    // Synthetic workload of 64 code regions at fixed addresses 13 words
+    // apart, each with a fixed behaviour so a predictor can learn it:
+    //   counted loops      back-edge taken trip-1 times, then not taken
+    //   correlated blocks  a data-dependent branch followed by two branches
+    //                      that repeat / invert its outcome
+    //   biased branches    7/8 towards a per-region direction
+    //   random branches    fair coin, unpredictable (1 region in 10)
+    // Regions are visited in a skewed random order (hot regions first).
+    inline std::vector<BranchRecord> generate_branch_trace(uint64_t n, uint64_t seed)
+    {
+        std::vector<BranchRecord> out;
+        out.reserve(static_cast<size_t>(n));
+        std::mt19937_64 rng(seed);
+
+        struct Region
+        {
+            unsigned kind;
+            unsigned trip;
+            bool bias;
+        };
+        Region regions[64];
+        for (auto &r : regions)
+        {
+            static const unsigned kKinds[10] = {0, 0, 0, 0, 1, 1, 1, 2, 2, 3};
+            r.kind = kKinds[rng() % 10U];
+            r.trip = 2U + static_cast<unsigned>(rng() % 15U);
+            r.bias = (rng() & 1U) != 0U;
+        }
+
+        auto emit = [&](uint32_t pc, bool taken) {
+            if (out.size() < n)
+            {
+                out.push_back(BranchRecord{pc, taken ? 1U : 0U});
+            }
+        };
+
+        while (out.size() < n)
+        {
+            // min of two draws favours low-numbered (hot) regions
+            const unsigned a = static_cast<unsigned>(rng() % 64U);
+            const unsigned b = static_cast<unsigned>(rng() % 64U);
+            const unsigned id = a < b ? a : b;
+            const Region &r = regions[id];
+            const uint32_t base = 0x00400000U + 0x34U * id;
+            switch (r.kind)
+            {
+                case 0:
+                    for (unsigned i = 0; i < r.trip; ++i)
+                    {
+                        emit(base + 0x10U, (i & 1U) != 0U);
+                        emit(base + 0x40U, i + 1U < r.trip);
+                    }
+                    break;
+                case 1:
+                {
+                    const bool t = (rng() & 1U) != 0U;
+                    emit(base, t);
+                    emit(base + 0x20U, t);
+                    emit(base + 0x44U, !t);
+                    break;
+                }
+                case 2:
+                    emit(base, ((rng() & 7U) != 0U) == r.bias);
+                    break;
+                default:
+                    emit(base, (rng() & 1U) != 0U);
+                    break;
+            }
+        }
+        return out;
+    }
+
+    // A trace in memory: a mapped file or generated records.
+    class BranchTrace
+    {
+    public:
+        BranchTrace(VerilatedContext *ctx, uint64_t default_branches, uint64_t seed)
+        {
+            const char *path = plusarg_str(ctx, "trace");
+            if (path != nullptr)
+            {
+                file_.reset(new MappedFile(path));
+                if (file_->size() % sizeof(BranchRecord) != 0U)
+                {
+                    std::cerr << "[TB] trace " << path << " is not a whole number of records" << std::endl;
+                    bad_ = true;
+                }
+                data_ = reinterpret_cast<const BranchRecord *>(file_->data());
+                size_ = file_->size() / sizeof(BranchRecord);
+                return;
+            }
+            owned_ = generate_branch_trace(plusarg_u64(ctx, "branches", default_branches), seed);
+            data_ = owned_.data();
+            size_ = owned_.size();
+
+            const char *out = plusarg_str(ctx, "gen_trace");
+            if (out != nullptr)
+            {
+                std::FILE *f = std::fopen(out, "wb");
+                if (f == nullptr || std::fwrite(data_, sizeof(BranchRecord), size_, f) != size_)
+                {
+                    std::cerr << "[TB] cannot write trace " << out << std::endl;
+                    bad_ = true;
+                }
+                if (f != nullptr)
+                {
+                    std::fclose(f);
+                }
+            }
+        }
+
+        // A trace built in memory, e.g. by generate_branch_trace().
+        explicit BranchTrace(std::vector<BranchRecord> records) : owned_(std::move(records))
+        {
+            data_ = owned_.data();
+            size_ = owned_.size();
+        }
+
+        bool ok() const { return !bad_ && (file_ == nullptr || file_->ok()); }
+        const BranchRecord *data() const { return data_; }
+        size_t size() const { return size_; }
+        const BranchRecord &operator[](size_t i) const { return data_[i]; }
+
+    private:
+        std::unique_ptr<MappedFile> file_;
+        const BranchRecord *data_ = nullptr;
+        size_t size_ = 0;
+        std::vector<BranchRecord> owned_;
+        bool bad_ = false;
+    };
+
+    // Misprediction tally for a replay.
+    struct PredictorStats
+    {
+        uint64_t branches = 0;
+        uint64_t mispredicts = 0;
+        uint64_t cycles = 0;
+        double seconds = 0.0;
+
+        double mpki() const
+        {
+            return branches != 0U ? 1000.0 * double(mispredicts) / double(branches) : 0.0;
+        }
+    };
+
+    // Inputs for one predictor cycle (dut_162 port naming).
+    struct BranchCycle
+    {
+        bool predict_valid;
+        uint32_t predict_pc;
+        bool train_valid;
+        bool train_taken;
+        bool train_mispredicted;
+        uint32_t train_history;
+        uint32_t train_pc;
+    };
+
+    // Drives a trace through a predictor as a pipeline that resolves a
+    // branch `latency` cycles after it was predicted. One branch is fetched
+    // (predicted) per cycle. When a resolved branch turns out mispredicted,
+    // every younger branch in flight, including the one predicted in the
+    // same cycle, is on the wrong path: it is squashed and fetching restarts
+    // after the mispredicted branch, so the predictor only ever trains and
+    // builds history on the correct path. In-flight branches live in a ring
+    // of `latency` entries.
+    //
+    //   while (!pipe.done()) {
+    //       const BranchCycle &c = pipe.begin();
+    //       ... drive c, read predict_taken / predict_history, clock ...
+    //       pipe.end(taken, history);
+    //   }
+    class BranchPipeline
+    {
+    public:
+        BranchPipeline(const BranchTrace &trace, unsigned latency, uint32_t pc_mask)
+            : trace_(trace), latency_(latency != 0U ? latency : 1U), pc_mask_(pc_mask), ring_(latency_)
+        {
+        }
+
+        bool done() const { return resolved_ == trace_.size(); }
+        uint64_t cycle() const { return stats_.cycles; }
+
+        const BranchCycle &begin()
+        {
+            cycle_in_ = BranchCycle{};
+            if (count_ != 0U && ring_[head_].cycle + latency_ == stats_.cycles)
+            {
+                const Entry &e = ring_[head_];
+                cycle_in_.train_valid = true;
+                cycle_in_.train_taken = e.taken;
+                cycle_in_.train_mispredicted = e.predicted != e.taken;
+                cycle_in_.train_history = e.history;
+                cycle_in_.train_pc = e.pc;
+            }
+            if (fetch_ < trace_.size())
+            {
+                cycle_in_.predict_valid = true;
+                cycle_in_.predict_pc = (trace_[fetch_].pc >> 2U) & pc_mask_;
+            }
+            return cycle_in_;
+        }
+
+        // Predictor outputs seen in this cycle, after the clock edge.
+        void end(bool predicted_taken, uint32_t predicted_history)
+        {
+            ++stats_.cycles;
+            if (cycle_in_.train_valid)
+            {
+                const uint64_t index = ring_[head_].index;
+                head_ = head_ + 1U == latency_ ? 0U : head_ + 1U;
+                --count_;
+                ++resolved_;
+                if (cycle_in_.train_mispredicted)
+                {
+                    ++stats_.mispredicts;
+                    count_ = 0U;
+                    fetch_ = index + 1U;
+                    return;
+                }
+            }
+            if (cycle_in_.predict_valid)
+            {
+                const unsigned tail = head_ + count_;
+                Entry &e = ring_[tail >= latency_ ? tail - latency_ : tail];
+                e.index = fetch_;
+                e.cycle = stats_.cycles - 1U;
+                e.pc = cycle_in_.predict_pc;
+                e.history = predicted_history;
+                e.predicted = predicted_taken;
+                e.taken = (trace_[fetch_].taken & 1U) != 0U;
+                ++count_;
+                ++fetch_;
+            }
+        }
+
+        const PredictorStats &stats(double seconds)
+        {
+            stats_.branches = resolved_;
+            stats_.seconds = seconds;
+            return stats_;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t index;
+            uint64_t cycle;
+            uint32_t pc;
+            uint32_t history;
+            bool predicted;
+            bool taken;
+        };
+
+        const BranchTrace &trace_;
+        unsigned latency_;
+        uint32_t pc_mask_;
+        std::vector<Entry> ring_;
+        unsigned head_ = 0;
+        unsigned count_ = 0;
+        uint64_t fetch_ = 0;
+        uint64_t resolved_ = 0;
+        BranchCycle cycle_in_{};
+        PredictorStats stats_;
+    };
+
+    inline void report_predictor(const char *name, const PredictorStats &s)
+    {
+        report_rate(name, "replayed branches", double(s.branches), s.seconds, "br");
+        std::cout << "[TB] " << name << " mispredictions: " << s.mispredicts << " (" << s.mpki()
+                  << " MPKI), " << s.cycles << " cycles ("
+                  << (s.branches != 0U ? double(s.cycles) / double(s.branches) : 0.0) << " per branch)"
+                  << std::endl;
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef COUNTER_SOAK_H
+#define COUNTER_SOAK_H
+
+// Sparse-checked soak runs for the counter testbenches (dut_099-102,
+// dut_107, dut_152, dut_159), switched on with `+soak=<cycles>`.
+//
+// The stimulus is a few reset/load events at random gaps plus, for DUTs
+// with an enable input, an enable that is high on every ena_period-th
+// clock edge. The reference is closed-form: the outputs after edge n
+// follow from the last event at or before n and the number of enabled
+// edges since, so the testbench does not mirror the DUT cycle by cycle.
+// Events are kept in a log and looked up with a forward cursor, i.e. in
+// O(1) per check for increasing n.
+//
+// Checks are sampled: every check_every-th edge (0 = never) plus the edge
+// of each event and the edge just before the next one, which sees the
+// longest run since the event.
+//
+//   +soak=<cycles>        soak length (default off)
+//   +check_every=<k>      sampling interval (default 64)
+//   +event_gap=<n>        mean edges between events (default 4096)
+//   +ena_period=<p>       enable high every p-th edge (default 3)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "tb_harness.h"
+
+namespace tb
+{
+    struct CounterEvent
+    {
+        uint64_t cycle;     // clock edge that sampled the reset/load
+        uint32_t value;     // DUT-specific, e.g. the loaded data
+    };
+
+    class EventLog
+    {
+    public:
+        void record(uint64_t cycle, uint32_t value) { events_.push_back(CounterEvent{cycle, value}); }
+        size_t size() const { return events_.size(); }
+
+        // Last event at or before `cycle`; the log must start at or before it.
+        const CounterEvent &last(uint64_t cycle)
+        {
+            if (events_[cursor_].cycle > cycle)
+            {
+                const auto it = std::upper_bound(
+                    events_.begin(), events_.end(), cycle,
+                    [](uint64_t c, const CounterEvent &e) { return c < e.cycle; });
+                cursor_ = static_cast<size_t>(it - events_.begin()) - 1U;
+            }
+            while (cursor_ + 1U < events_.size() && events_[cursor_ + 1U].cycle <= cycle)
+            {
+                ++cursor_;
+            }
+            return events_[cursor_];
+        }
+
+    private:
+        std::vector<CounterEvent> events_;
+        size_t cursor_ = 0;
+    };
+
+    // Edges in (after, upto] on which an enable high every `period`-th edge
+    // (edges 0, period, 2*period, ...) is set.
+    inline uint64_t enabled_edges(uint64_t after, uint64_t upto, uint64_t period)
+    {
+        return upto / period - after / period;
+    }
+
+    struct SoakConfig
+    {
+        uint64_t cycles = 0;
+        uint64_t check_every = 64;
+        uint64_t event_gap = 4096;
+        uint64_t ena_period = 3;
+
+        static SoakConfig from_plusargs(VerilatedContext *ctx)
+        {
+            SoakConfig c;
+            c.cycles = plusarg_u64(ctx, "soak", 0);
+            c.check_every = plusarg_u64(ctx, "check_every", c.check_every);
+            c.event_gap = std::max<uint64_t>(1U, plusarg_u64(ctx, "event_gap", c.event_gap));
+            c.ena_period = std::max<uint64_t>(1U, plusarg_u64(ctx, "ena_period", c.ena_period));
+            return c;
+        }
+    };
+
+    // Runs the soak. Edge 0 is always an event; event values are drawn
+    // from [0, values).
+    //   step(n, event, value, ena)  drives and clocks edge n, returns the output
+    //   expect(e, n)                output after edge n given e = last event <= n
+    template <typename Step, typename Expect>
+    bool run_counter_soak(const char *dut, const SoakConfig &cfg, uint32_t values, uint64_t seed, Step step,
+                          Expect expect)
+    {
+        std::mt19937_64 rng(seed);
+        EventLog log;
+        uint64_t next_event = 0;
+        uint64_t next_sample = cfg.check_every != 0U ? cfg.check_every : ~uint64_t(0);
+        uint64_t ena_in = 0;
+        uint64_t checks = 0;
+
+        Stopwatch sw;
+        for (uint64_t n = 0; n < cfg.cycles; ++n)
+        {
+            const bool event = n == next_event;
+            uint32_t value = 0;
+            if (event)
+            {
+                value = static_cast<uint32_t>(rng() % values);
+                log.record(n, value);
+                next_event = n + 1U + rng() % (2U * cfg.event_gap);
+            }
+            const bool ena = ena_in == 0U;
+            ena_in = ena ? cfg.ena_period - 1U : ena_in - 1U;
+
+            const uint32_t got = step(n, event, value, ena);
+            if (event || n + 1U == next_event || n == next_sample)
+            {
+                if (n == next_sample)
+                {
+                    next_sample += cfg.check_every;
+                }
+                ++checks;
+                const CounterEvent &e = log.last(n);
+                const uint32_t want = expect(e, n);
+                if (got != want)
+                {
+                    std::cerr << "[TB] " << dut << " soak failed at cycle " << n << " (last event at cycle "
+                              << e.cycle << ", value " << e.value << "): expected " << want << ", got " << got
+                              << std::endl;
+                    return false;
+                }
+            }
+        }
+        const double secs = sw.seconds();
+
+        // Checker share: the closed form timed alone over the same log.
+        const uint64_t samples = std::min<uint64_t>(cfg.cycles, uint64_t(1) << 20U);
+        volatile uint32_t sink = 0;
+        Stopwatch cal;
+        for (uint64_t n = 0; n < samples; ++n)
+        {
+            sink = expect(log.last(n), n);
+        }
+        const double per_check = samples != 0U ? cal.seconds() / double(samples) : 0.0;
+        (void)sink;
+
+        report_rate(dut, "soak cycles", double(cfg.cycles), secs, "cyc");
+        std::cout << "[TB] " << dut << " soak: " << log.size() << " events, " << checks << " checks";
+        if (cfg.check_every != 0U)
+        {
+            std::cout << " (every " << cfg.check_every << " cycles and around events)";
+        }
+        else
+        {
+            std::cout << " (around events only)";
+        }
+        std::cout << ", checker " << (secs > 0.0 ? 100.0 * double(checks) * per_check / secs : 0.0)
+                  << "% of the run" << std::endl;
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef FSM_COVERAGE_H
+#define FSM_COVERAGE_H
+
+// FSM transition coverage for the state machine testbenches, built with
+// `make DUT=<n> FSM_COV=1` (TB_FSM_COV). Only the DUT's `state` register is
+// made public (tb/fsm_state.vlt). The testbench samples it after every
+// rising clock edge into a dense N x N matrix of transition counts,
+// N = 2^state_bits, allocated up front. A sample is one increment and no
+// branch: the row of the first sample after construction or restart() is a
+// spare row that is never reported.
+//
+// At exit the taken arcs are written as "from to count" lines to
+// $FSM_COV_FILE (coverage/dut_<n>/fsm_transitions.dat from the Makefile).
+// Matrices of worker threads combine with merge(); the files of several
+// runs combine by summing counts per arc, which `make coverage_report` does
+// into fsm_transitions.info next to coverage.info.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "tb_harness.h"
+
+namespace tb
+{
+    class FsmTransitionMatrix
+    {
+    public:
+        explicit FsmTransitionMatrix(unsigned state_bits)
+            : n_(1U << state_bits), prev_(n_), counts_(size_t(n_ + 1U) * n_, 0U)
+        {
+        }
+
+        void sample(uint32_t state)
+        {
+            const uint32_t s = state & (n_ - 1U);
+            ++counts_[size_t(prev_) * n_ + s];
+            prev_ = s;
+        }
+
+        // The next sample starts a new trace, e.g. on another model instance.
+        void restart() { prev_ = n_; }
+
+        void merge(const FsmTransitionMatrix &other)
+        {
+            for (size_t i = 0; i < counts_.size() && i < other.counts_.size(); ++i)
+            {
+                counts_[i] += other.counts_[i];
+            }
+        }
+
+        unsigned states() const { return n_; }
+        uint64_t count(uint32_t from, uint32_t to) const { return counts_[size_t(from) * n_ + to]; }
+
+        uint64_t samples() const
+        {
+            uint64_t n = 0;
+            for (uint64_t c : counts_)
+            {
+                n += c;
+            }
+            return n;
+        }
+
+        unsigned arcs_taken() const
+        {
+            unsigned arcs = 0;
+            for (size_t i = 0; i < size_t(n_) * n_; ++i)
+            {
+                arcs += counts_[i] != 0U ? 1U : 0U;
+            }
+            return arcs;
+        }
+
+        unsigned states_visited() const
+        {
+            unsigned visited = 0;
+            for (uint32_t to = 0; to < n_; ++to)
+            {
+                bool seen = false;
+                for (uint32_t from = 0; from <= n_ && !seen; ++from)
+                {
+                    seen = counts_[size_t(from) * n_ + to] != 0U;
+                }
+                visited += seen ? 1U : 0U;
+            }
+            return visited;
+        }
+
+        bool write(const char *path, const char *dut) const
+        {
+            std::FILE *f = std::fopen(path, "w");
+            if (f == nullptr)
+            {
+                return false;
+            }
+            std::fprintf(f, "# fsm_transitions %s states=%u\n", dut, n_);
+            for (uint32_t from = 0; from < n_; ++from)
+            {
+                for (uint32_t to = 0; to < n_; ++to)
+                {
+                    if (count(from, to) != 0U)
+                    {
+                        std::fprintf(f, "%u %u %llu\n", from, to,
+                                     static_cast<unsigned long long>(count(from, to)));
+                    }
+                }
+            }
+            return std::fclose(f) == 0;
+        }
+
+        // Cost of one sample, timed on a scratch matrix of the same size.
+        double ns_per_sample() const
+        {
+            FsmTransitionMatrix scratch(*this);
+            scratch.restart();
+            scratch.counts_.assign(counts_.size(), 0U);
+            const uint64_t kSamples = uint64_t(1) << 22U;
+            uint64_t x = 0x9e3779b97f4a7c15ULL;
+            Stopwatch sw;
+            for (uint64_t i = 0; i < kSamples; ++i)
+            {
+                x ^= x << 13U;
+                x ^= x >> 7U;
+                x ^= x << 17U;
+                scratch.sample(static_cast<uint32_t>(x));
+            }
+            const double secs = sw.seconds();
+            // keep the loop from being optimised away
+            return scratch.samples() == kSamples ? secs * 1e9 / double(kSamples) : 0.0;
+        }
+
+        // Seconds since construction, i.e. the testbench run so far.
+        double run_seconds() const { return run_.seconds(); }
+
+    private:
+        uint32_t n_;
+        uint32_t prev_;
+        std::vector<uint64_t> counts_;     // (n_ + 1) rows of n_, row n_ = entry row
+        Stopwatch run_;
+    };
+
+    // Writes the matrix to $FSM_COV_FILE (when set) and reports arcs and
+    // the measured sampling overhead against the run time.
+    inline void finish_fsm_coverage(const char *dut, const FsmTransitionMatrix &m)
+    {
+        const double run = m.run_seconds();
+        const uint64_t samples = m.samples();
+        const double ns = m.ns_per_sample();
+        const double overhead = double(samples) * ns * 1e-9;
+        std::cout << "[TB] " << dut << " fsm transitions: " << m.arcs_taken() << " arcs taken, "
+                  << m.states_visited() << " of " << m.states() << " states visited, " << samples
+                  << " samples" << std::endl;
+        std::cout << "[TB] " << dut << " fsm coverage overhead: " << ns << " ns/sample, " << overhead * 1e6
+                  << " us of a " << run * 1e3 << " ms run (" << (run > 0.0 ? 100.0 * overhead / run : 0.0)
+                  << "%)" << std::endl;
+
+        const char *path = std::getenv("FSM_COV_FILE");
+        if (path != nullptr && path[0] != '\0' && !m.write(path, dut))
+        {
+            std::cerr << "[TB] " << dut << " cannot write fsm coverage " << path << std::endl;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,408 @@
+#ifndef FSM_EXPLORE_H
+#define FSM_EXPLORE_H
+
+// Breadth-first exploration of a small control FSM through its inputs, for
+// the state machine testbenches (dut_131, dut_138, dut_151, dut_157).
+//
+// The DUT is a black box with an observable full state: the testbench gives
+// a key covering everything that decides future behaviour (the state
+// register plus any live counters), read from the registers in a PUBLIC=1
+// build or from its reference model otherwise. Starting at reset, every
+// input vector is applied to every newly discovered full state. Before each
+// trial the full state is restored by loading the registers (PUBLIC=1), or
+// else by reset and replay of the shortest input path to it.
+//
+// Transitions are counted on the FSM state alone (`state(key)`): the search
+// yields the reachable states and state-to-state edges. The cover is a short
+// set of input sequences from reset that together take every edge, found by
+// walking the explored full-state graph to the nearest untaken edge.
+//
+// Regression replays the cover committed as tb/fsm_covers/<dut>.cov (see
+// run_fsm_modes); the testbench's scripted phases only run on request.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "verilated.h"
+#include "tb_harness.h"
+
+namespace tb
+{
+    // One input vector per clock, applied after reset.
+    using FsmSequence = std::vector<uint32_t>;
+
+    struct FsmHooks
+    {
+        std::function<void()> reset;                // DUT and model to the reset state
+        std::function<void(uint32_t)> step;         // one clock with this input vector, checked
+        std::function<uint64_t()> key;              // current full state
+        std::function<unsigned(uint64_t)> state;    // FSM state part of a key
+        std::function<bool(uint64_t)> restore;      // load a full state; empty or false: replay
+    };
+
+    struct FsmCover
+    {
+        uint64_t nodes = 0;             // full states reached
+        uint64_t states = 0;
+        uint64_t edges = 0;
+        bool complete = true;           // false when the node limit cut the search short
+        bool reproducible = true;       // false when a replayed path missed its full state
+        uint64_t search_cycles = 0;
+        double search_seconds = 0.0;
+        std::vector<FsmSequence> sequences;
+
+        uint64_t cycles() const
+        {
+            uint64_t n = 0;
+            for (const FsmSequence &s : sequences)
+            {
+                n += s.size();
+            }
+            return n;
+        }
+    };
+
+    inline FsmCover explore_fsm(const FsmHooks &h, unsigned input_bits, uint64_t max_nodes)
+    {
+        struct Node
+        {
+            uint64_t key;
+            uint32_t parent;
+            uint32_t input;
+            uint32_t depth;
+        };
+        const uint32_t kNoNode = ~uint32_t(0);
+
+        FsmCover cover;
+        Stopwatch sw;
+        std::vector<Node> nodes;                    // also the BFS queue
+        std::unordered_map<uint64_t, uint32_t> index;
+        std::set<std::pair<unsigned, unsigned>> edges;
+        std::vector<uint32_t> succ;                 // [node * inputs + input]: next full state
+        std::vector<unsigned> succ_state;           // and its FSM state
+        std::set<unsigned> states;
+
+        auto path_to = [&](uint32_t n) {
+            FsmSequence path(nodes[n].depth);
+            for (uint32_t i = n; i != 0U; i = nodes[i].parent)
+            {
+                path[nodes[i].depth - 1U] = nodes[i].input;
+            }
+            return path;
+        };
+
+        h.reset();
+        nodes.push_back(Node{h.key(), 0U, 0U, 0U});
+        index.emplace(nodes[0].key, 0U);
+        states.insert(h.state(nodes[0].key));
+
+        const uint32_t inputs = 1U << input_bits;
+        for (uint32_t n = 0; n < nodes.size(); ++n)
+        {
+            const Node node = nodes[n];
+            const unsigned from = h.state(node.key);
+            FsmSequence path;
+            for (uint32_t u = 0; u < inputs; ++u)
+            {
+                if (!h.restore || !h.restore(node.key))
+                {
+                    if (path.size() != node.depth)
+                    {
+                        path = path_to(n);
+                    }
+                    h.reset();
+                    for (uint32_t in : path)
+                    {
+                        h.step(in);
+                    }
+                    cover.search_cycles += path.size();
+                    if (h.key() != node.key)
+                    {
+                        cover.reproducible = false;
+                        return cover;
+                    }
+                }
+                h.step(u);
+                ++cover.search_cycles;
+
+                const uint64_t key = h.key();
+                const unsigned to = h.state(key);
+                states.insert(to);
+                edges.insert(std::make_pair(from, to));
+                succ_state.push_back(to);
+                const auto found = index.find(key);
+                if (found != index.end())
+                {
+                    succ.push_back(found->second);
+                }
+                else if (nodes.size() >= max_nodes)
+                {
+                    cover.complete = false;
+                    succ.push_back(kNoNode);
+                }
+                else
+                {
+                    succ.push_back(static_cast<uint32_t>(nodes.size()));
+                    index.emplace(key, static_cast<uint32_t>(nodes.size()));
+                    nodes.push_back(Node{key, n, u, node.depth + 1U});
+                }
+            }
+        }
+
+        // Greedy walk over the explored graph: from reset, repeatedly take a
+        // shortest path to the nearest untaken edge. A sequence ends when no
+        // untaken edge is reachable and the next one starts from reset.
+        std::set<std::pair<unsigned, unsigned>> taken;
+        std::vector<uint32_t> seen(nodes.size(), kNoNode);
+        std::vector<std::pair<uint32_t, uint32_t>> via(nodes.size());     // (previous node, input)
+        std::vector<uint32_t> queue;
+        uint32_t pass = 0;
+        while (taken.size() < edges.size())
+        {
+            FsmSequence seq;
+            uint32_t cur = 0;
+            while (cur != kNoNode)
+            {
+                // BFS from `cur` for the closest (node, input) on an untaken edge.
+                ++pass;
+                queue.assign(1U, cur);
+                seen[cur] = pass;
+                uint32_t hit = kNoNode;
+                uint32_t hit_input = 0;
+                for (size_t q = 0; q < queue.size() && hit == kNoNode; ++q)
+                {
+                    const uint32_t m = queue[q];
+                    for (uint32_t u = 0; u < inputs; ++u)
+                    {
+                        const size_t t = size_t(m) * inputs + u;
+                        if (taken.count(std::make_pair(h.state(nodes[m].key), succ_state[t])) == 0U)
+                        {
+                            hit = m;
+                            hit_input = u;
+                            break;
+                        }
+                        const uint32_t next = succ[t];
+                        if (next != kNoNode && seen[next] != pass)
+                        {
+                            seen[next] = pass;
+                            via[next] = std::make_pair(m, u);
+                            queue.push_back(next);
+                        }
+                    }
+                }
+                if (hit == kNoNode)
+                {
+                    break;
+                }
+
+                FsmSequence hop(1U, hit_input);
+                for (uint32_t i = hit; i != cur; i = via[i].first)
+                {
+                    hop.push_back(via[i].second);
+                    taken.insert(std::make_pair(h.state(nodes[via[i].first].key), h.state(nodes[i].key)));
+                }
+                const size_t t = size_t(hit) * inputs + hit_input;
+                taken.insert(std::make_pair(h.state(nodes[hit].key), succ_state[t]));
+                seq.insert(seq.end(), hop.rbegin(), hop.rend());
+                cur = succ[t];
+            }
+            if (seq.empty())
+            {
+                break;
+            }
+            cover.sequences.push_back(std::move(seq));
+        }
+
+        cover.nodes = nodes.size();
+        cover.states = states.size();
+        cover.edges = edges.size();
+        cover.search_seconds = sw.seconds();
+        return cover;
+    }
+
+    struct FsmReplay
+    {
+        uint64_t cycles = 0;
+        uint64_t states = 0;            // distinct states and transitions taken
+        uint64_t edges = 0;
+    };
+
+    // Runs each sequence from reset through the checked step.
+    inline FsmReplay replay_fsm_sequences(const FsmHooks &h, const std::vector<FsmSequence> &sequences)
+    {
+        FsmReplay r;
+        std::set<unsigned> states;
+        std::set<std::pair<unsigned, unsigned>> edges;
+        for (const FsmSequence &seq : sequences)
+        {
+            h.reset();
+            unsigned from = h.state(h.key());
+            states.insert(from);
+            for (uint32_t in : seq)
+            {
+                h.step(in);
+                const unsigned to = h.state(h.key());
+                states.insert(to);
+                edges.insert(std::make_pair(from, to));
+                from = to;
+            }
+            r.cycles += seq.size();
+        }
+        r.states = states.size();
+        r.edges = edges.size();
+        return r;
+    }
+
+    // A `#` header with the reachable state and transition counts, then one
+    // sequence per line, input vectors in hex separated by spaces.
+    inline bool save_fsm_sequences(const char *path, const char *dut, const FsmCover &cover)
+    {
+        std::ofstream out(path);
+        out << "# " << dut << " " << cover.states << " states " << cover.edges << " transitions\n";
+        for (const FsmSequence &seq : cover.sequences)
+        {
+            for (size_t i = 0; i < seq.size(); ++i)
+            {
+                out << (i != 0U ? " " : "") << std::hex << seq[i];
+            }
+            out << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    // Reads a saved cover; `states` / `edges` get the header counts, 0 when absent.
+    inline bool load_fsm_sequences(const char *path, std::vector<FsmSequence> &sequences, uint64_t &states,
+                                   uint64_t &edges)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            return false;
+        }
+        states = 0;
+        edges = 0;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line[0] == '#')
+            {
+                std::istringstream header(line.substr(1));
+                std::string name, word;
+                header >> name >> states >> word >> edges;
+                continue;
+            }
+            std::istringstream fields(line);
+            FsmSequence seq;
+            uint32_t v = 0;
+            while (fields >> std::hex >> v)
+            {
+                seq.push_back(v);
+            }
+            if (!seq.empty())
+            {
+                sequences.push_back(std::move(seq));
+            }
+        }
+        return true;
+    }
+
+    inline void report_fsm_cover(const char *dut, const FsmCover &c)
+    {
+        std::cout << "[TB] " << dut << " fsm explore: " << c.nodes << " full states, " << c.states
+                  << " states and " << c.edges << " transitions reachable (search " << c.search_cycles
+                  << " cycles in " << c.search_seconds << " s)" << std::endl;
+        std::cout << "[TB] " << dut << " fsm cover: " << c.sequences.size() << " sequences, " << c.cycles()
+                  << " cycles (" << (c.edges != 0U ? double(c.cycles()) / double(c.edges) : 0.0)
+                  << " per transition)" << std::endl;
+        if (!c.complete)
+        {
+            std::cout << "[TB] " << dut << " fsm explore hit the +fsm_nodes limit, cover may be partial"
+                      << std::endl;
+        }
+    }
+
+    enum class FsmMode
+    {
+        Scripted,       // run the scripted phases
+        Replayed,       // a cover replaced them
+        Failed
+    };
+
+    inline bool replay_fsm_cover(const char *dut, const FsmHooks &h, const char *path)
+    {
+        std::vector<FsmSequence> sequences;
+        uint64_t states = 0, edges = 0;
+        if (!load_fsm_sequences(path, sequences, states, edges))
+        {
+            std::cerr << "[TB] " << dut << " cannot read fsm cover " << path << " (regenerate it with "
+                      << "+fsm_explore +fsm_save=" << path << ")" << std::endl;
+            return false;
+        }
+        const FsmReplay r = replay_fsm_sequences(h, sequences);
+        std::cout << "[TB] " << dut << " fsm replay: " << sequences.size() << " sequences, " << r.cycles
+                  << " cycles from " << path << ", " << r.states << " states and " << r.edges
+                  << " transitions taken" << std::endl;
+        if (r.states < states || r.edges < edges)
+        {
+            std::cerr << "[TB] " << dut << " fsm cover " << path << " takes " << r.states << "/" << states
+                      << " states and " << r.edges << "/" << edges << " transitions (stale cover?)" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // The +fsm_* modes of a testbench. By default the committed cover
+    // tb/fsm_covers/<dut>.cov is replayed (paths are relative to the
+    // repository root, where `make` runs the testbench), and it must take
+    // every state and transition its header lists.
+    //   +fsm_scripted         run the scripted phases instead
+    //   +fsm_replay=<path>    replay another saved cover
+    //   +fsm_explore          search, report and replay a fresh cover
+    //   +fsm_nodes=<n>        full-state limit of the search (default 1M)
+    //   +fsm_save=<path>      with +fsm_explore: write the cover
+    inline FsmMode run_fsm_modes(VerilatedContext *ctx, const char *dut, const FsmHooks &h,
+                                 unsigned input_bits)
+    {
+        if (plusarg_flag(ctx, "fsm_scripted"))
+        {
+            return FsmMode::Scripted;
+        }
+        if (!plusarg_flag(ctx, "fsm_explore"))
+        {
+            const char *replay = plusarg_str(ctx, "fsm_replay");
+            const std::string path = replay != nullptr ? std::string(replay)
+                                                       : std::string("tb/fsm_covers/") + dut + ".cov";
+            return replay_fsm_cover(dut, h, path.c_str()) ? FsmMode::Replayed : FsmMode::Failed;
+        }
+
+        const FsmCover cover = explore_fsm(h, input_bits, plusarg_u64(ctx, "fsm_nodes", 1U << 20U));
+        if (!cover.reproducible)
+        {
+            std::cerr << "[TB] " << dut << " fsm explore: replay from reset did not reach the recorded "
+                      << "full state (key misses some state)" << std::endl;
+            return FsmMode::Failed;
+        }
+        report_fsm_cover(dut, cover);
+        replay_fsm_sequences(h, cover.sequences);
+
+        const char *save = plusarg_str(ctx, "fsm_save");
+        if (save != nullptr && !save_fsm_sequences(save, dut, cover))
+        {
+            std::cerr << "[TB] " << dut << " cannot write fsm cover " << save << std::endl;
+            return FsmMode::Failed;
+        }
+        return FsmMode::Replayed;
+    }
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef GF2_JUMP_H
+#define GF2_JUMP_H
+
+// Jump-ahead model for linear (over GF(2)) state machines of up to 64 bits,
+// such as the LFSRs in dut_110/dut_112. One step is an n x n bit matrix M;
+// the state after k steps is M^k * s, evaluated in O(n^2 log k) from the
+// cached powers M^(2^i).
+
+#include <array>
+#include <cstdint>
+
+namespace tb
+{
+    class Gf2Matrix
+    {
+    public:
+        explicit Gf2Matrix(unsigned width = 64U) : width_(width), cols_{} {}
+
+        static Gf2Matrix identity(unsigned width)
+        {
+            Gf2Matrix m(width);
+            for (unsigned j = 0; j < width; ++j)
+            {
+                m.cols_[j] = 1ULL << j;
+            }
+            return m;
+        }
+
+        // Column j is the image of basis vector e_j under a linear step function.
+        template <typename StepFn>
+        static Gf2Matrix from_step(unsigned width, StepFn step)
+        {
+            Gf2Matrix m(width);
+            for (unsigned j = 0; j < width; ++j)
+            {
+                m.cols_[j] = step(1ULL << j) & m.mask();
+            }
+            return m;
+        }
+
+        uint64_t apply(uint64_t v) const
+        {
+            uint64_t r = 0;
+            for (unsigned j = 0; v != 0U && j < width_; ++j, v >>= 1U)
+            {
+                r ^= cols_[j] & (0ULL - (v & 1ULL));
+            }
+            return r;
+        }
+
+        // (*this) * rhs, i.e. apply rhs first.
+        Gf2Matrix operator*(const Gf2Matrix &rhs) const
+        {
+            Gf2Matrix r(width_);
+            for (unsigned j = 0; j < width_; ++j)
+            {
+                r.cols_[j] = apply(rhs.cols_[j]);
+            }
+            return r;
+        }
+
+        bool operator==(const Gf2Matrix &rhs) const
+        {
+            return width_ == rhs.width_ && cols_ == rhs.cols_;
+        }
+
+        bool is_identity() const { return *this == identity(width_); }
+        unsigned width() const { return width_; }
+        uint64_t mask() const { return width_ >= 64U ? ~0ULL : ((1ULL << width_) - 1ULL); }
+
+    private:
+        unsigned width_;
+        std::array<uint64_t, 64> cols_;
+    };
+
+    class Gf2Jump
+    {
+    public:
+        explicit Gf2Jump(const Gf2Matrix &step) : step_(step)
+        {
+            pow2_[0] = step;
+            for (unsigned i = 1; i < 64U; ++i)
+            {
+                pow2_[i] = pow2_[i - 1] * pow2_[i - 1];
+            }
+        }
+
+        // M^k as a matrix.
+        Gf2Matrix power(uint64_t k) const
+        {
+            Gf2Matrix r = Gf2Matrix::identity(step_.width());
+            for (unsigned i = 0; k != 0U; ++i, k >>= 1U)
+            {
+                if (k & 1ULL)
+                {
+                    r = pow2_[i] * r;
+                }
+            }
+            return r;
+        }
+
+        // State after k steps from `state`.
+        uint64_t advance(uint64_t state, uint64_t k) const
+        {
+            for (unsigned i = 0; k != 0U; ++i, k >>= 1U)
+            {
+                if (k & 1ULL)
+                {
+                    state = pow2_[i].apply(state);
+                }
+            }
+            return state;
+        }
+
+        const Gf2Matrix &step() const { return step_; }
+
+    private:
+        Gf2Matrix step_;
+        std::array<Gf2Matrix, 64> pow2_;
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef LANES_H
+#define LANES_H
+
+// Helpers for the lane-packed testbenches (tb/tb_<n>_lanes.cpp), built with
+// `make DUT=<n> LANES=<k>`: the model is lanes_top from tb/lanes.awk, k
+// copies of the DUT with bit i of every port belonging to copy i. A
+// testbench drives k independent random streams per eval() and checks them
+// all at once against a bit-sliced golden model, i.e. the reference
+// equations evaluated with bitwise operators on whole 64-bit words.
+//
+// With REF=<n> the plain Vdut_<n> is linked in as well (TB_REF) and the
+// same loop runs on it with a one-lane mask, for the speedup figure.
+
+#include <cstdint>
+#include <iostream>
+
+#include "tb_harness.h"
+
+namespace tb
+{
+    inline uint64_t lane_mask(unsigned lanes)
+    {
+        return lanes >= 64U ? ~uint64_t(0) : (uint64_t(1) << lanes) - 1U;
+    }
+
+    inline unsigned first_lane(uint64_t diff)
+    {
+        return static_cast<unsigned>(__builtin_ctzll(diff));
+    }
+
+    // 64 independent random bits per call (xorshift64*).
+    class LaneRandom
+    {
+    public:
+        explicit LaneRandom(uint64_t seed) : s_(seed != 0U ? seed : 0x9e3779b97f4a7c15ULL) {}
+
+        uint64_t word()
+        {
+            s_ ^= s_ >> 12U;
+            s_ ^= s_ << 25U;
+            s_ ^= s_ >> 27U;
+            return s_ * 0x2545f4914f6cdd1dULL;
+        }
+
+        // Each bit set with probability 1/2^k, e.g. for rare resets.
+        uint64_t bits(unsigned k)
+        {
+            uint64_t w = ~uint64_t(0);
+            for (unsigned i = 0; i < k; ++i)
+            {
+                w &= word();
+            }
+            return w;
+        }
+
+    private:
+        uint64_t s_;
+    };
+
+    // Checked vectors per second, packed and (when timed) single instance.
+    inline void report_lanes(const char *dut, unsigned lanes, uint64_t cycles, double secs,
+                             uint64_t single_cycles, double single_secs)
+    {
+        const double packed = secs > 0.0 ? double(cycles) * lanes / secs : 0.0;
+        report_rate(dut, "lane-packed vectors", double(cycles) * lanes, secs, "vec");
+        std::cout << "[TB] " << dut << " " << lanes << " lanes: " << cycles << " evals" << std::endl;
+        if (single_cycles == 0U)
+        {
+            return;
+        }
+        const double single = single_secs > 0.0 ? double(single_cycles) / single_secs : 0.0;
+        report_rate(dut, "single-instance vectors", double(single_cycles), single_secs, "vec");
+        std::cout << "[TB] " << dut << " lane-packed speedup: " << (single > 0.0 ? packed / single : 0.0)
+                  << "x" << std::endl;
+    }
+}
+
+#endif
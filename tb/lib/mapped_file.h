@@ -0,0 +1,67 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// Read-only memory map of an input file for the streaming testbench modes
+// (serial byte streams, branch traces). Large inputs are paged in on demand
+// instead of being copied into the testbench.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace tb
+{
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const char *path)
+        {
+            const int fd = ::open(path, O_RDONLY);
+            struct stat st;
+            if (fd >= 0 && ::fstat(fd, &st) == 0 && st.st_size > 0)
+            {
+                void *p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED)
+                {
+                    ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                    map_ = p;
+                    size_ = static_cast<size_t>(st.st_size);
+                }
+            }
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+            if (map_ == nullptr)
+            {
+                std::cerr << "[TB] cannot map input file " << path << std::endl;
+            }
+        }
+
+        ~MappedFile()
+        {
+            if (map_ != nullptr)
+            {
+                ::munmap(map_, size_);
+            }
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        bool ok() const { return map_ != nullptr; }
+        const uint8_t *data() const { return static_cast<const uint8_t *>(map_); }
+        size_t size() const { return size_; }
+
+    private:
+        void *map_ = nullptr;
+        size_t size_ = 0;
+    };
+}
+
+#endif
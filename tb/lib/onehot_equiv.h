@@ -0,0 +1,235 @@
+#ifndef ONEHOT_EQUIV_H
+#define ONEHOT_EQUIV_H
+
+// Exhaustive equivalence of a hand-written one-hot next-state block
+// (dut_132, dut_158) against a binary-encoded reference FSM.
+//
+// The DUT is combinational: a state vector and inputs in, next-state bits
+// and outputs out. Every state vector (all 2^states, legal or not) is
+// tried with every input value. The DUT is evaluated once per combination,
+// and its result bits are gathered into 64-lane words, lane j holding
+// combination base + j. The reference runs bit-sliced on those words:
+// it encodes a legal one-hot state to a binary index, looks up
+// table[index][input] and compares all 64 lanes with a few word operations.
+//
+// Lanes whose state is not one-hot are compared instead with the OR of
+// what each hot bit alone would give, which is what sum-of-products
+// one-hot equations compute. A mismatch there is reported, not failed,
+// together with how the DUT's next state looks from illegal states.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "tb_harness.h"
+
+namespace tb
+{
+    struct OneHotReference
+    {
+        unsigned states;                // one-hot state bits = binary states
+        unsigned inputs;                // input bits
+        unsigned outputs;               // compared result bits
+        uint32_t next_mask;             // result bits forming the whole next state, or 0
+        std::vector<uint32_t> table;    // [state << inputs | input]: result bits
+    };
+
+    struct OneHotEquivStats
+    {
+        uint64_t combinations = 0;
+        uint64_t legal = 0;
+        uint64_t illegal = 0;
+        uint64_t illegal_or_match = 0;  // illegal lanes matching the OR of hot bits
+        uint64_t next_zero_hot = 0;     // DUT next state from illegal states
+        uint64_t next_one_hot = 0;
+        uint64_t next_multi_hot = 0;
+        double seconds = 0.0;
+    };
+
+    namespace detail
+    {
+        inline unsigned popcount(uint64_t w) { return static_cast<unsigned>(__builtin_popcountll(w)); }
+
+        // Lane j of the block at `base` is combination base + j; bit b of
+        // that index across the 64 lanes.
+        inline uint64_t index_plane(uint64_t base, unsigned b)
+        {
+            static const uint64_t kLow[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL,
+                                             0xF0F0F0F0F0F0F0F0ULL, 0xFF00FF00FF00FF00ULL,
+                                             0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+            return b < 6U ? kLow[b] : (((base >> b) & 1U) != 0U ? ~uint64_t(0) : 0U);
+        }
+
+        // Lanes where the words w[0..n) have exactly one bit set / more than one.
+        inline void hot_count(const uint64_t *w, unsigned n, uint64_t &one, uint64_t &many)
+        {
+            one = 0;
+            many = 0;
+            for (unsigned i = 0; i < n; ++i)
+            {
+                many |= one & w[i];
+                one |= w[i];
+            }
+            one &= ~many;
+        }
+    }
+
+    // eval(state, input) drives the DUT and returns its result bits in the
+    // layout of ref.table. Returns false on a mismatch in a legal state.
+    template <typename Eval>
+    bool check_onehot_equivalence(const char *dut, const OneHotReference &ref, Eval eval, OneHotEquivStats &st)
+    {
+        const unsigned n = ref.states;
+        const uint32_t in_values = 1U << ref.inputs;
+        const uint64_t total = uint64_t(1) << (n + ref.inputs);
+        unsigned index_bits = 0;
+        while ((1U << index_bits) < n)
+        {
+            ++index_bits;
+        }
+        std::vector<uint64_t> got(ref.outputs), want(ref.outputs), ored(ref.outputs);
+        std::vector<uint64_t> state(n), index(index_bits), match_in(in_values), match_state(n), next;
+
+        Stopwatch sw;
+        for (uint64_t base = 0; base < total; base += 64U)
+        {
+            const unsigned lanes = total - base < 64U ? static_cast<unsigned>(total - base) : 64U;
+            const uint64_t live = lanes == 64U ? ~uint64_t(0) : (uint64_t(1) << lanes) - 1U;
+
+            // DUT: one eval per combination, gathered into lane words.
+            std::fill(got.begin(), got.end(), 0U);
+            for (unsigned j = 0; j < lanes; ++j)
+            {
+                const uint64_t c = base + j;
+                const uint32_t r = eval(static_cast<uint32_t>(c >> ref.inputs),
+                                        static_cast<uint32_t>(c & (in_values - 1U)));
+                for (unsigned o = 0; o < ref.outputs; ++o)
+                {
+                    got[o] |= uint64_t((r >> o) & 1U) << j;
+                }
+            }
+
+            // Reference, 64 lanes per word operation.
+            for (uint32_t v = 0; v < in_values; ++v)
+            {
+                uint64_t m = ~uint64_t(0);
+                for (unsigned b = 0; b < ref.inputs; ++b)
+                {
+                    const uint64_t p = detail::index_plane(base, b);
+                    m &= ((v >> b) & 1U) != 0U ? p : ~p;
+                }
+                match_in[v] = m;
+            }
+            for (unsigned i = 0; i < n; ++i)
+            {
+                state[i] = detail::index_plane(base, ref.inputs + i);
+            }
+            uint64_t legal = 0, many = 0;
+            detail::hot_count(state.data(), n, legal, many);
+            legal &= live;
+
+            // Binary encoding of the legal one-hot lanes, and the decode of
+            // each binary state.
+            for (unsigned b = 0; b < index_bits; ++b)
+            {
+                index[b] = 0;
+                for (unsigned i = 0; i < n; ++i)
+                {
+                    index[b] |= ((i >> b) & 1U) != 0U ? state[i] : 0U;
+                }
+            }
+            for (unsigned s = 0; s < n; ++s)
+            {
+                uint64_t m = legal;
+                for (unsigned b = 0; b < index_bits; ++b)
+                {
+                    m &= ((s >> b) & 1U) != 0U ? index[b] : ~index[b];
+                }
+                match_state[s] = m;
+            }
+
+            std::fill(want.begin(), want.end(), 0U);
+            std::fill(ored.begin(), ored.end(), 0U);
+            for (unsigned s = 0; s < n; ++s)
+            {
+                for (uint32_t v = 0; v < in_values; ++v)
+                {
+                    const uint32_t r = ref.table[(size_t(s) << ref.inputs) | v];
+                    for (unsigned o = 0; o < ref.outputs; ++o)
+                    {
+                        if (((r >> o) & 1U) != 0U)
+                        {
+                            want[o] |= match_state[s] & match_in[v];
+                            ored[o] |= state[s] & match_in[v];
+                        }
+                    }
+                }
+            }
+
+            uint64_t bad = 0, or_diff = 0;
+            next.clear();
+            for (unsigned o = 0; o < ref.outputs; ++o)
+            {
+                bad |= (got[o] ^ want[o]) & legal;
+                or_diff |= got[o] ^ ored[o];
+                if (((ref.next_mask >> o) & 1U) != 0U)
+                {
+                    next.push_back(got[o]);
+                }
+            }
+            if (bad != 0U)
+            {
+                const unsigned j = static_cast<unsigned>(__builtin_ctzll(bad));
+                const uint64_t c = base + j;
+                uint32_t expect = 0, actual = 0;
+                for (unsigned o = 0; o < ref.outputs; ++o)
+                {
+                    expect |= uint32_t((want[o] >> j) & 1U) << o;
+                    actual |= uint32_t((got[o] >> j) & 1U) << o;
+                }
+                std::cerr << "[TB] " << dut << " one-hot equivalence failed: state=0x" << std::hex
+                          << (c >> ref.inputs) << " input=0x" << (c & (in_values - 1U)) << " expected 0x"
+                          << expect << " got 0x" << actual << std::dec << std::endl;
+                return false;
+            }
+
+            const uint64_t illegal = ~legal & live;
+            uint64_t one = 0, multi = 0;
+            detail::hot_count(next.data(), static_cast<unsigned>(next.size()), one, multi);
+            st.combinations += lanes;
+            st.legal += detail::popcount(legal);
+            st.illegal += detail::popcount(illegal);
+            st.illegal_or_match += detail::popcount(illegal & ~or_diff);
+            st.next_zero_hot += detail::popcount(illegal & ~one & ~multi);
+            st.next_one_hot += detail::popcount(illegal & one);
+            st.next_multi_hot += detail::popcount(illegal & multi);
+        }
+        st.seconds = sw.seconds();
+
+        if (st.legal != uint64_t(n) * in_values)
+        {
+            std::cerr << "[TB] " << dut << " one-hot equivalence covered " << st.legal
+                      << " legal combinations, expected " << uint64_t(n) * in_values << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    inline void report_onehot_equivalence(const char *dut, const OneHotReference &ref,
+                                          const OneHotEquivStats &st)
+    {
+        report_rate(dut, "one-hot equivalence combinations", double(st.combinations), st.seconds, "comb");
+        std::cout << "[TB] " << dut << " one-hot equivalence: " << st.legal << " legal combinations match the "
+                  << "binary FSM; " << st.illegal << " illegal (not one-hot), " << st.illegal_or_match
+                  << " of them match the OR of their hot states" << std::endl;
+        if (ref.next_mask != 0U)
+        {
+            std::cout << "[TB] " << dut << " next state from illegal states: " << st.next_zero_hot
+                      << " zero-hot, " << st.next_one_hot << " one-hot, " << st.next_multi_hot << " multi-hot"
+                      << std::endl;
+        }
+    }
+}
+
+#endif
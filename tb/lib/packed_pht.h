@@ -0,0 +1,123 @@
+#ifndef PACKED_PHT_H
+#define PACKED_PHT_H
+
+// Bit-packed pattern history tables for the branch predictor reference
+// models. Two-bit saturating counters (0 strongly not taken .. 3 strongly
+// taken) are stored 32 per uint64_t, counter i in bits 2*(i%32)+1 : 2*(i%32)
+// of word i/32, so a 128-entry table is four words. The prediction is the
+// counter's high bit and the update is branch-free; results are identical
+// to the switch-based counter update the testbenches started with.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tb
+{
+    // Next value of 2-bit counter c (0..3) trained with `taken` (0/1):
+    // +1 if taken, -1 if not, holding at 3 and 0.
+    inline uint64_t pht_counter_step(uint64_t c, uint64_t taken)
+    {
+        const uint64_t limit = (0U - taken) & 3U;   // 3 when taken, 0 when not
+        const uint64_t move = static_cast<uint64_t>(c != limit);
+        return c + (move & taken) - (move & (taken ^ 1U));
+    }
+
+    class PackedPht
+    {
+    public:
+        PackedPht(unsigned index_bits, uint8_t init)
+            : words_(((size_t(1) << index_bits) + 31U) / 32U)
+        {
+            fill(init);
+        }
+
+        void fill(uint8_t init)
+        {
+            const uint64_t pattern = (init & 3U) * 0x5555555555555555ULL;
+            for (auto &w : words_)
+            {
+                w = pattern;
+            }
+        }
+
+        uint8_t get(uint32_t i) const
+        {
+            return static_cast<uint8_t>((words_[i >> 5U] >> ((i & 31U) << 1U)) & 3U);
+        }
+
+        bool predict(uint32_t i) const
+        {
+            return ((words_[i >> 5U] >> (((i & 31U) << 1U) + 1U)) & 1U) != 0U;
+        }
+
+        void update(uint32_t i, bool taken)
+        {
+            uint64_t &w = words_[i >> 5U];
+            const unsigned shift = (i & 31U) << 1U;
+            const uint64_t c = (w >> shift) & 3U;
+            w ^= (c ^ pht_counter_step(c, taken ? 1U : 0U)) << shift;
+        }
+
+    private:
+        std::vector<uint64_t> words_;
+    };
+
+    // Independent tables for many predictor instances (one per seed in a
+    // multi-seed regression), stored back to back. Batched calls cover up
+    // to 64 consecutive instances and exchange one bit per instance.
+    class PackedPhtBank
+    {
+    public:
+        PackedPhtBank(unsigned instances, unsigned index_bits, uint8_t init)
+            : stride_(((size_t(1) << index_bits) + 31U) / 32U), words_(stride_ * instances)
+        {
+            fill(init);
+        }
+
+        void fill(uint8_t init)
+        {
+            const uint64_t pattern = (init & 3U) * 0x5555555555555555ULL;
+            for (auto &w : words_)
+            {
+                w = pattern;
+            }
+        }
+
+        // Bit j: prediction of instance first+j at index[j].
+        uint64_t predict_batch(unsigned first, unsigned n, const uint32_t *index) const
+        {
+            uint64_t mask = 0U;
+            const uint64_t *base = &words_[stride_ * first];
+            for (unsigned j = 0; j < n; ++j, base += stride_)
+            {
+                const uint32_t i = index[j];
+                mask |= ((base[i >> 5U] >> (((i & 31U) << 1U) + 1U)) & 1U) << j;
+            }
+            return mask;
+        }
+
+        // Trains instance first+j at index[j] with taken bit j, for every set
+        // bit j of `valid`.
+        void train_batch(unsigned first, unsigned n, const uint32_t *index, uint64_t valid, uint64_t taken)
+        {
+            uint64_t *base = &words_[stride_ * first];
+            for (unsigned j = 0; j < n; ++j, base += stride_)
+            {
+                const uint32_t i = index[j];
+                uint64_t &w = base[i >> 5U];
+                const unsigned shift = (i & 31U) << 1U;
+                const uint64_t c = (w >> shift) & 3U;
+                const uint64_t next = pht_counter_step(c, (taken >> j) & 1U);
+                // no-op for instances that do not train this cycle
+                w ^= ((c ^ next) & (0U - ((valid >> j) & 1U))) << shift;
+            }
+        }
+
+    private:
+        size_t stride_;
+        std::vector<uint64_t> words_;
+    };
+}
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef RESET_STRESS_H
+#define RESET_STRESS_H
+
+// Asynchronous reset stress for the DUTs with `posedge areset` /
+// `negedge aresetn` flops, switched on with `+reset_stress[=<events>]`.
+//
+// Each seed runs its own model under random inputs and injects `events`
+// resets at random points, one injection kind per event:
+//   low phase      assert while clk is low, with new inputs in the same eval
+//   high phase     the same while clk is high
+//   rising edge    assert in the same eval as a rising clock edge
+//   back to back   assert / release / assert ... with no clock edge between
+//   held           assert, then keep it asserted over 1-3 clock cycles
+// The outputs must show the documented reset state right after every eval
+// with reset asserted, and after a release without a clock edge. Releases
+// land on a clock low/high phase or on a rising edge (not checked: the
+// edge then clocks the FSM out of reset, which the scripted phases cover).
+// Every step is a single eval, so an event costs 2 evals plus its extra
+// pulses and held cycles.
+//
+// A testbench describes its DUT with a target struct:
+//   static constexpr const char *kResetState;  documented reset outputs
+//   static void reset(Dut *, bool on);          drive the reset, any polarity
+//   static void inputs(Dut *, uint64_t bits);   random data inputs
+//   static bool in_reset(const Dut *);          outputs show the reset state
+//
+// Seeds 1..+reset_seeds (default kResetStressSeeds) are shared out over
+// +threads workers; each seed runs on its own model, so results do not
+// depend on the thread count or the machine.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "tb_harness.h"
+
+namespace tb
+{
+    enum ResetInjection
+    {
+        kResetAtLowPhase,
+        kResetAtHighPhase,
+        kResetWithRisingEdge,
+        kResetBackToBack,
+        kResetHeld,
+        kResetInjections
+    };
+
+    static constexpr uint64_t kResetStressSeeds = 8;
+
+    static const char *const kResetInjectionNames[kResetInjections] = {
+        "low phase", "high phase", "rising edge", "back to back", "held"};
+
+    struct ResetStressStats
+    {
+        uint64_t resets = 0;                    // assertions, pulses included
+        uint64_t events = 0;
+        uint64_t evals = 0;
+        uint64_t reset_evals = 0;               // from first assertion to release
+        uint64_t by_kind[kResetInjections] = {};
+
+        void add(const ResetStressStats &o)
+        {
+            resets += o.resets;
+            events += o.events;
+            evals += o.evals;
+            reset_evals += o.reset_evals;
+            for (unsigned k = 0; k < kResetInjections; ++k)
+            {
+                by_kind[k] += o.by_kind[k];
+            }
+        }
+    };
+
+    template <typename Dut, typename Target>
+    bool stress_resets_seed(const char *name, uint64_t seed, uint64_t events, ResetStressStats &stats)
+    {
+        auto ctx = std::make_unique<VerilatedContext>();
+        ctx->traceEverOn(false);
+        auto dut = std::make_unique<Dut>(ctx.get());
+        std::mt19937_64 rng(seed);
+        uint64_t evals = 0;
+
+        auto eval = [&]() {
+            dut->eval();
+            ctx->timeInc(1);
+            ++evals;
+        };
+        // Next half cycle; inputs change while the clock is low.
+        auto half_cycle = [&]() {
+            dut->clk = !dut->clk;
+            if (!dut->clk)
+            {
+                Target::inputs(dut.get(), rng());
+            }
+            eval();
+        };
+        auto check = [&](uint64_t event, ResetInjection how, const char *when) {
+            if (Target::in_reset(dut.get()))
+            {
+                return true;
+            }
+            std::cerr << "[TB] " << name << " reset stress: seed " << seed << " event " << event << " ("
+                      << kResetInjectionNames[how] << ", " << when << "): outputs not in the reset state ("
+                      << Target::kResetState << ")" << std::endl;
+            return false;
+        };
+        auto assert_reset = [&](uint64_t event, ResetInjection how, const char *when) {
+            Target::reset(dut.get(), true);
+            eval();
+            ++stats.resets;
+            return check(event, how, when);
+        };
+
+        dut->clk = 0;
+        Target::reset(dut.get(), false);
+        Target::inputs(dut.get(), rng());
+        eval();
+        for (uint64_t e = 0; e < events; ++e)
+        {
+            for (uint64_t h = rng() % 16U; h != 0U; --h)
+            {
+                half_cycle();
+            }
+            const uint64_t r = rng();
+            const ResetInjection how = static_cast<ResetInjection>(r % kResetInjections);
+            const unsigned extra = 1U + static_cast<unsigned>((r >> 8) % 3U);
+            const bool need_low = how == kResetAtLowPhase || how == kResetWithRisingEdge;
+            if ((need_low && dut->clk != 0U) || (how == kResetAtHighPhase && dut->clk == 0U))
+            {
+                half_cycle();
+            }
+
+            const uint64_t first = evals;
+            bool ok = true;
+            switch (how)
+            {
+                case kResetAtLowPhase:
+                case kResetAtHighPhase:
+                    Target::inputs(dut.get(), r >> 16);
+                    ok = assert_reset(e, how, "assert");
+                    break;
+                case kResetWithRisingEdge:
+                    dut->clk = 1;
+                    ok = assert_reset(e, how, "assert");
+                    break;
+                case kResetBackToBack:
+                    ok = assert_reset(e, how, "assert");
+                    for (unsigned p = 0; p < extra && ok; ++p)
+                    {
+                        Target::reset(dut.get(), false);
+                        eval();
+                        ok = check(e, how, "release between pulses") && assert_reset(e, how, "pulse");
+                    }
+                    break;
+                default:
+                    ok = assert_reset(e, how, "assert");
+                    for (unsigned c = 0; c < 2U * extra && ok; ++c)
+                    {
+                        half_cycle();
+                        ok = check(e, how, "held over a clock edge");
+                    }
+                    break;
+            }
+            if (!ok)
+            {
+                return false;
+            }
+
+            Target::reset(dut.get(), false);
+            if (dut->clk == 0U && ((r >> 60) & 1U) != 0U)
+            {
+                dut->clk = 1;
+                eval();
+            }
+            else
+            {
+                eval();
+                if (!check(e, how, "release"))
+                {
+                    return false;
+                }
+            }
+            stats.reset_evals += evals - first;
+            ++stats.by_kind[how];
+            ++stats.events;
+        }
+        stats.evals += evals;
+        return true;
+    }
+
+    // The +reset_stress mode; true when off or passed.
+    template <typename Dut, typename Target>
+    bool run_reset_stress(VerilatedContext *ctx, const char *name)
+    {
+        if (!plusarg_flag(ctx, "reset_stress"))
+        {
+            return true;
+        }
+        const uint64_t events = plusarg_u64(ctx, "reset_stress", 100000);
+        const unsigned workers = worker_count(ctx);
+        const uint64_t seeds = std::max<uint64_t>(1U, plusarg_u64(ctx, "reset_seeds", kResetStressSeeds));
+
+        std::vector<ResetStressStats> per_worker(workers);
+        std::atomic<uint64_t> next{0};
+        std::atomic<bool> ok{true};
+        Stopwatch sw;
+        run_workers(workers, [&](unsigned w) {
+            for (uint64_t s = next++; s < seeds && ok; s = next++)
+            {
+                if (!stress_resets_seed<Dut, Target>(name, s + 1U, events, per_worker[w]))
+                {
+                    ok = false;
+                }
+            }
+        });
+        const double secs = sw.seconds();
+        if (!ok)
+        {
+            return false;
+        }
+
+        ResetStressStats total;
+        for (const ResetStressStats &s : per_worker)
+        {
+            total.add(s);
+        }
+        report_rate(name, "reset stress resets", double(total.resets), secs, "rst");
+        std::cout << "[TB] " << name << " reset stress: " << seeds << " seeds on " << workers << " worker(s), "
+                  << total.events << " events (";
+        for (unsigned k = 0; k < kResetInjections; ++k)
+        {
+            std::cout << (k != 0U ? ", " : "") << kResetInjectionNames[k] << " " << total.by_kind[k];
+        }
+        std::cout << "), " << (total.events != 0U ? double(total.reset_evals) / double(total.events) : 0.0)
+                  << " evals per event, " << total.evals << " evals in all" << std::endl;
+        return true;
+    }
+}
+
+#endif
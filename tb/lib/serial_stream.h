@@ -0,0 +1,211 @@
+#ifndef SERIAL_STREAM_H
+#define SERIAL_STREAM_H
+
+// Streaming harness for the serial byte receivers (dut_135/136/137).
+// A byte buffer (memory-mapped file or generated data) is serialized into
+// start/data/[parity]/stop frames with random idle gaps and injected framing
+// (bad stop bit) and parity errors, fed to the DUT one bit per clock, and
+// the bytes reported through done/out_byte are diffed against the bytes
+// of the frames that were sent intact.
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "mapped_file.h"
+#include "tb_harness.h"
+
+namespace tb
+{
+    // Read-only input bytes: the file named by +infile=<path> (mmap'd), or
+    // +bytes=<n> pseudo-random bytes when no file is given.
+    class ByteSource
+    {
+    public:
+        ByteSource(VerilatedContext *ctx, uint64_t default_bytes, uint64_t seed)
+        {
+            const char *path = plusarg_str(ctx, "infile");
+            if (path != nullptr)
+            {
+                file_.reset(new MappedFile(path));
+                data_ = file_->data();
+                size_ = file_->size();
+                return;
+            }
+            std::mt19937_64 rng(seed);
+            owned_.resize(static_cast<size_t>(plusarg_u64(ctx, "bytes", default_bytes)));
+            for (auto &b : owned_)
+            {
+                b = static_cast<uint8_t>(rng());
+            }
+            data_ = owned_.data();
+            size_ = owned_.size();
+        }
+
+        bool ok() const { return file_ == nullptr || file_->ok(); }
+        const uint8_t *data() const { return data_; }
+        size_t size() const { return size_; }
+
+    private:
+        std::unique_ptr<MappedFile> file_;
+        const uint8_t *data_ = nullptr;
+        size_t size_ = 0;
+        std::vector<uint8_t> owned_;
+    };
+
+    struct SerialConfig
+    {
+        bool parity = false;          // odd parity bit after the data (dut_137)
+        uint32_t frame_err_ppm = 0;   // frames sent with stop bit 0
+        uint32_t parity_err_ppm = 0;  // frames sent with the wrong parity bit
+        unsigned idle_min = 0;        // idle (1) bits before each start bit
+        unsigned idle_max = 0;
+        uint64_t seed = 1;
+
+        // +frame_err_ppm, +parity_err_ppm, +idle_min, +idle_max override the defaults.
+        void from_plusargs(VerilatedContext *ctx)
+        {
+            frame_err_ppm = static_cast<uint32_t>(plusarg_u64(ctx, "frame_err_ppm", frame_err_ppm));
+            parity_err_ppm = static_cast<uint32_t>(plusarg_u64(ctx, "parity_err_ppm", parity_err_ppm));
+            idle_min = static_cast<unsigned>(plusarg_u64(ctx, "idle_min", idle_min));
+            idle_max = std::max(idle_min, static_cast<unsigned>(plusarg_u64(ctx, "idle_max", idle_max)));
+        }
+    };
+
+    struct SerialResult
+    {
+        uint64_t cycles = 0;
+        uint64_t frames = 0;
+        uint64_t dropped = 0;      // frames sent with an injected error
+        uint64_t received = 0;
+        uint64_t recoveries = 0;   // errors followed by a good byte
+        uint64_t recovery_cycles = 0;
+        uint64_t recovery_max = 0;
+        double seconds = 0.0;
+    };
+
+    // Streams `n` bytes through `dut`. tick(dut, ctx) clocks the DUT one
+    // cycle with `in` already set, so the testbench's per-edge work (FSM
+    // coverage sampling) also runs while streaming. read_byte(dut) returns
+    // the received byte (or -1 for receivers without a data output) and is
+    // only called while done is high. The received bytes are diffed after
+    // the run; returns false on the first mismatch.
+    template <typename Model, typename Tick, typename ReadByte>
+    bool run_serial_stream(Model *dut, VerilatedContext *ctx, const char *name, const uint8_t *data,
+                           size_t n, const SerialConfig &cfg, Tick tick, ReadByte read_byte,
+                           SerialResult &res)
+    {
+        std::mt19937_64 rng(cfg.seed);
+        const unsigned idle_span = cfg.idle_max - cfg.idle_min + 1U;
+        std::vector<int> expected;
+        std::vector<int> received;
+        expected.reserve(n);
+        received.reserve(n);
+        uint64_t error_cycle = 0;
+        bool recovering = false;
+        bool after_error = false;
+
+        auto bit = [&](unsigned b) {
+            dut->in = b & 1U;
+            tick(dut, ctx);
+            ++res.cycles;
+            if (dut->done)
+            {
+                received.push_back(read_byte(dut));
+                if (recovering)
+                {
+                    const uint64_t lat = res.cycles - error_cycle;
+                    res.recovery_cycles += lat;
+                    res.recovery_max = std::max(res.recovery_max, lat);
+                    ++res.recoveries;
+                    recovering = false;
+                }
+            }
+        };
+
+        Stopwatch sw;
+        for (size_t k = 0; k < n; ++k)
+        {
+            const uint8_t byte = data[k];
+            // A receiver waiting out a bad stop bit needs one idle bit to resync.
+            unsigned idle = cfg.idle_min + static_cast<unsigned>(rng() % idle_span);
+            if (after_error && idle == 0U)
+            {
+                idle = 1U;
+            }
+            for (unsigned i = 0; i < idle; ++i)
+            {
+                bit(1U);
+            }
+            const bool bad_stop = (rng() % 1000000U) < cfg.frame_err_ppm;
+            const bool bad_parity = cfg.parity && !bad_stop && (rng() % 1000000U) < cfg.parity_err_ppm;
+            bit(0U);
+            unsigned ones = 0;
+            for (unsigned i = 0; i < 8U; ++i)
+            {
+                const unsigned b = (byte >> i) & 1U;
+                ones += b;
+                bit(b);
+            }
+            if (cfg.parity)
+            {
+                const unsigned odd_bit = (ones & 1U) ^ 1U;
+                bit(bad_parity ? odd_bit ^ 1U : odd_bit);
+            }
+            bit(bad_stop ? 0U : 1U);
+            ++res.frames;
+            after_error = bad_stop;
+            if (bad_stop || bad_parity)
+            {
+                ++res.dropped;
+                error_cycle = res.cycles;
+                recovering = true;
+            }
+            else
+            {
+                expected.push_back(byte);
+            }
+        }
+        bit(1U);
+        res.seconds = sw.seconds();
+        res.received = received.size();
+
+        const size_t common = std::min(expected.size(), received.size());
+        for (size_t i = 0; i < common; ++i)
+        {
+            if (expected[i] >= 0 && received[i] >= 0 && expected[i] != received[i])
+            {
+                std::cerr << "[TB] " << name << " stream mismatch at good frame " << i
+                          << ": expected 0x" << std::hex << expected[i] << " got 0x" << received[i]
+                          << std::dec << std::endl;
+                return false;
+            }
+        }
+        if (expected.size() != received.size())
+        {
+            std::cerr << "[TB] " << name << " stream received " << received.size() << " bytes, expected "
+                      << expected.size() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    inline void report_serial(const char *name, const SerialResult &res)
+    {
+        report_rate(name, "received bytes", double(res.received), res.seconds, "B");
+        std::cout << "[TB] " << name << " stream: " << res.frames << " frames, " << res.dropped
+                  << " with injected errors, " << res.cycles << " cycles";
+        if (res.recoveries != 0U)
+        {
+            std::cout << ", error recovery avg " << double(res.recovery_cycles) / double(res.recoveries)
+                      << " max " << res.recovery_max << " cycles to next byte";
+        }
+        std::cout << std::endl;
+    }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+// Design-space sweeps (SWEEP=..., dut_171/dut_172). The Makefile builds the
+// DUT once per configuration and generates tb_sweep.h, whose
+// TB_SWEEP_MODELS(X) lists X(Vsweep_<config>, "<overrides>") for each one;
+// include this header after it. Every configuration becomes one job, the
+// jobs are pulled by +threads workers, and each job runs in a
+// VerilatedContext of its own, so models in different jobs are independent.
+// The testbench supplies the per-configuration run and prints the table.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "verilated.h"
+#include "tb_harness.h"
+
+namespace tb
+{
+    // Value of NAME in a "NAME=v NAME2=w" override list, else `fallback`.
+    inline unsigned sweep_param(const char *config, const char *name, unsigned fallback)
+    {
+        const size_t len = std::strlen(name);
+        for (const char *p = config; *p != '\0'; ++p)
+        {
+            if ((p == config || p[-1] == ' ') && std::strncmp(p, name, len) == 0 && p[len] == '=')
+            {
+                return static_cast<unsigned>(std::strtoul(p + len + 1, nullptr, 0));
+            }
+        }
+        return fallback;
+    }
+
+    // Names a sweep model type for the testbench's generic make lambda.
+    template <typename Model>
+    struct SweepModel
+    {
+        using type = Model;
+    };
+
+    template <typename Stats>
+    struct SweepJob
+    {
+        const char *config;
+        std::function<bool(VerilatedContext *, Stats &)> run;
+        Stats stats;
+        bool ok = false;
+    };
+
+    struct SweepRun
+    {
+        unsigned workers = 0;
+        double seconds = 0.0;
+        bool ok = true;     // every job passed
+    };
+
+#ifdef TB_SWEEP_MODELS
+    // One job per model in TB_SWEEP_MODELS. make(SweepModel<Model>{}, config)
+    // returns the job's run function.
+    template <typename Stats, typename Make>
+    std::vector<SweepJob<Stats>> sweep_jobs(Make make)
+    {
+        std::vector<SweepJob<Stats>> jobs;
+#define TB_SWEEP_JOB(Model, config) jobs.push_back({config, make(SweepModel<Model>{}, config), Stats{}});
+        TB_SWEEP_MODELS(TB_SWEEP_JOB)
+#undef TB_SWEEP_JOB
+        return jobs;
+    }
+#endif
+
+    // Runs every job on min(+threads, jobs) workers, each pulling the next
+    // job until none are left.
+    template <typename Stats>
+    SweepRun run_sweep(VerilatedContext *ctx, std::vector<SweepJob<Stats>> &jobs)
+    {
+        SweepRun res;
+        std::atomic<size_t> next{0};
+        res.workers = std::min<unsigned>(worker_count(ctx), static_cast<unsigned>(jobs.size()));
+        Stopwatch sw;
+        run_workers(res.workers, [&](unsigned) {
+            for (size_t i = next++; i < jobs.size(); i = next++)
+            {
+                auto job_ctx = std::make_unique<VerilatedContext>();
+                job_ctx->traceEverOn(false);
+                jobs[i].ok = jobs[i].run(job_ctx.get(), jobs[i].stats);
+            }
+        });
+        res.seconds = sw.seconds();
+        for (const SweepJob<Stats> &j : jobs)
+        {
+            res.ok = res.ok && j.ok;
+        }
+        return res;
+    }
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef TB_HARNESS_H
+#define TB_HARNESS_H
+
+// Shared helpers for the long-running testbench modes (soak, benchmark,
+// full-sweep). Default runs never need these; they are switched on with
+// plusargs passed through the Makefile, e.g. `make DUT=112 TB_ARGS=+full_period`.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "verilated.h"
+
+namespace tb
+{
+    // True when `+name` (or `+name=...`) was given on the command line.
+    inline bool plusarg_flag(VerilatedContext *ctx, const char *name)
+    {
+        const char *match = ctx->commandArgsPlusMatch(name);
+        if (match == nullptr || match[0] != '+')
+        {
+            return false;
+        }
+        const char *rest = match + 1 + std::strlen(name);
+        return rest[0] == '\0' || rest[0] == '=';
+    }
+
+    // Value of `+name=<n>`, or `fallback` when absent or malformed.
+    inline uint64_t plusarg_u64(VerilatedContext *ctx, const char *name, uint64_t fallback)
+    {
+        const char *match = ctx->commandArgsPlusMatch(name);
+        if (match == nullptr || match[0] != '+')
+        {
+            return fallback;
+        }
+        const char *rest = match + 1 + std::strlen(name);
+        if (rest[0] != '=' || rest[1] == '\0')
+        {
+            return fallback;
+        }
+        char *end = nullptr;
+        const unsigned long long value = std::strtoull(rest + 1, &end, 0);
+        return (end != nullptr && *end == '\0') ? static_cast<uint64_t>(value) : fallback;
+    }
+
+    // String value of `+name=<text>`, or nullptr when absent.
+    inline const char *plusarg_str(VerilatedContext *ctx, const char *name)
+    {
+        const char *match = ctx->commandArgsPlusMatch(name);
+        if (match == nullptr || match[0] != '+')
+        {
+            return nullptr;
+        }
+        const char *rest = match + 1 + std::strlen(name);
+        return (rest[0] == '=' && rest[1] != '\0') ? rest + 1 : nullptr;
+    }
+
+    // Worker threads for parallel modes: `+threads=<n>`, else all cores.
+    inline unsigned worker_count(VerilatedContext *ctx)
+    {
+        unsigned hw = std::thread::hardware_concurrency();
+        if (hw == 0U)
+        {
+            hw = 1U;
+        }
+        const uint64_t n = plusarg_u64(ctx, "threads", hw);
+        return static_cast<unsigned>(std::max<uint64_t>(1U, n));
+    }
+
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+        double seconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Runs fn(worker_index) on `workers` threads and waits for all of them.
+    template <typename Fn>
+    void run_workers(unsigned workers, Fn fn)
+    {
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w)
+        {
+            pool.emplace_back([&fn, w]() { fn(w); });
+        }
+        for (auto &t : pool)
+        {
+            t.join();
+        }
+    }
+
+    inline void report_rate(const char *dut, const char *what, double count, double secs,
+                            const char *unit)
+    {
+        const double rate = secs > 0.0 ? count / secs : 0.0;
+        std::cout << "[TB] " << dut << " " << what << ": " << static_cast<uint64_t>(count)
+                  << " in " << secs << " s (" << rate / 1e6 << " M" << unit << "/s)"
+                  << std::endl;
+    }
+}
+
+#endif
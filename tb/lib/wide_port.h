@@ -0,0 +1,66 @@
+#ifndef WIDE_PORT_H
+#define WIDE_PORT_H
+
+// Width-agnostic access to Verilator ports, so one testbench can drive a
+// parameterized top whose port types change with the parameters
+// (CData/SData/IData/QData up to 64 bits, VlWide<W> above).
+
+#include <cstddef>
+#include <cstdint>
+
+#include "verilated.h"
+
+namespace tb
+{
+    // Writes 32-bit words w[0..] (little endian) into the port.
+    template <typename T>
+    inline void put_words(T &port, const uint32_t *w)
+    {
+        uint64_t v = w[0];
+        if (sizeof(T) > 4U)
+        {
+            v |= static_cast<uint64_t>(w[1]) << 32U;
+        }
+        port = static_cast<T>(v);
+    }
+
+    template <std::size_t W>
+    inline void put_words(VlWide<W> &port, const uint32_t *w)
+    {
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            port[i] = w[i];
+        }
+    }
+
+    // 32-bit word i of the port (zero beyond an integral port's width).
+    template <typename T>
+    inline uint32_t get_word(const T &port, std::size_t i)
+    {
+        return i < 2U ? static_cast<uint32_t>(static_cast<uint64_t>(port) >> (32U * i)) : 0U;
+    }
+
+    template <std::size_t W>
+    inline uint32_t get_word(const VlWide<W> &port, std::size_t i)
+    {
+        return i < W ? port[i] : 0U;
+    }
+
+    // `width` (<= 32) bits of the port starting at bit `lsb`.
+    template <typename T>
+    inline uint32_t get_bits(const T &port, std::size_t lsb, unsigned width)
+    {
+        const std::size_t w = lsb >> 5U;
+        const uint64_t pair = get_word(port, w) | (static_cast<uint64_t>(get_word(port, w + 1U)) << 32U);
+        return static_cast<uint32_t>((pair >> (lsb & 31U)) & ((1ULL << width) - 1ULL));
+    }
+
+    // 8-bit field k of the port.
+    template <typename T>
+    inline uint8_t get_byte(const T &port, std::size_t k)
+    {
+        return static_cast<uint8_t>(get_word(port, k >> 2U) >> (8U * (k & 3U)));
+    }
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_088.h"
+#include "lib/reset_stress.h"
 
 static inline void tick(Vdut_088 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -24,9 +25,18 @@ static inline void apply_async_reset(Vdut_088 *dut, uint8_t &q_model) {
     q_model = 0;
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "q=0";
+    static void reset(Vdut_088 *dut, bool on) { dut->ar = on; }
+    static void inputs(Vdut_088 *dut, uint64_t bits) { dut->d = bits & 1u; }
+    static bool in_reset(const Vdut_088 *dut) { return dut->q == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_088>(ctx.get());
@@ -72,6 +82,10 @@ int main(int argc, char **argv) {
         return EXIT_FAILURE;
     }
 
+    if (!tb::run_reset_stress<Vdut_088, ResetTarget>(ctx.get(), "dut_088")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_088 passed: async reset DFF" << std::endl;
 
 #if VM_COVERAGE
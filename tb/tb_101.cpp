@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_101.h"
+#include "lib/counter_soak.h"
 
 struct Stim101 {
     uint8_t reset;
@@ -23,6 +24,7 @@ static inline void tick(Vdut_101 *dut, VerilatedContext *ctx) {
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_101>(ctx.get());
@@ -57,6 +59,23 @@ int main(int argc, char **argv) {
         }
     }
 
+    // +soak=<cycles>: long run against the closed-form reference (lib/counter_soak.h).
+    const tb::SoakConfig soak = tb::SoakConfig::from_plusargs(ctx.get());
+    if (soak.cycles != 0u) {
+        const bool ok = tb::run_counter_soak(
+            "dut_101", soak, 1u, 101u,
+            [&](uint64_t, bool event, uint32_t, bool) {
+                dut->reset = event;
+                tick(dut.get(), ctx.get());
+                return uint32_t(dut->q);
+            },
+            // q runs 1..10 from 1 at the last reset
+            [](const tb::CounterEvent &e, uint64_t n) { return uint32_t(1u + (n - e.cycle) % 10u); });
+        if (!ok) {
+            return EXIT_FAILURE;
+        }
+    }
+
     std::cout << "[TB] dut_101 passed: 1..10 counter with wrap to 1" << std::endl;
 
 #if VM_COVERAGE
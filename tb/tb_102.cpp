@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_102.h"
+#include "lib/counter_soak.h"
 
 struct Stim102 {
     uint8_t reset;
@@ -24,6 +25,7 @@ static inline void tick(Vdut_102 *dut, VerilatedContext *ctx) {
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_102>(ctx.get());
@@ -69,6 +71,26 @@ int main(int argc, char **argv) {
         }
     }
 
+    // +soak=<cycles>: long run against the closed-form reference (lib/counter_soak.h).
+    const tb::SoakConfig soak = tb::SoakConfig::from_plusargs(ctx.get());
+    if (soak.cycles != 0u) {
+        const bool ok = tb::run_counter_soak(
+            "dut_102", soak, 1u, 102u,
+            [&](uint64_t, bool event, uint32_t, bool ena) {
+                dut->reset = event;
+                dut->slowena = ena;
+                tick(dut.get(), ctx.get());
+                return uint32_t(dut->q);
+            },
+            // q counts the slowena edges since the last reset, mod 10
+            [&](const tb::CounterEvent &e, uint64_t n) {
+                return uint32_t(tb::enabled_edges(e.cycle, n, soak.ena_period) % 10u);
+            });
+        if (!ok) {
+            return EXIT_FAILURE;
+        }
+    }
+
     std::cout << "[TB] dut_102 passed: gated BCD counter" << std::endl;
 
 #if VM_COVERAGE
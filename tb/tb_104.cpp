@@ -1,11 +1,20 @@
+#include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_104.h"
+#ifdef TB_PUBLIC
+#include "Vdut_104___024root.h"
+#endif
+#include "lib/state_ranges.h"
+#include "lib/tb_harness.h"
+
+static constexpr uint32_t kStates = 1000;
 
 static inline void tick(Vdut_104 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -16,9 +25,92 @@ static inline void tick(Vdut_104 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+// c_enable (bits 0..2) and OneHertz (bit 3) while the digits read n.
+static inline uint8_t enables(uint32_t n) {
+    return static_cast<uint8_t>(1u | (n % 10u == 9u ? 2u : 0u) | (n % 100u == 99u ? 4u : 0u)
+                                | (n == 999u ? 8u : 0u));
+}
+
+// One clock out of every count in [r.first, r.last) on a model of its own,
+// counting the c_enable / OneHertz assertions per bit.
+static bool run_range(const tb::StateRange &r, std::vector<uint8_t> &visits,
+                      std::array<uint64_t, 4> &asserted) {
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->traceEverOn(false);
+    auto dut = std::make_unique<Vdut_104>(ctx.get());
+    dut->clk = 0;
+    dut->reset = 1;
+    tick(dut.get(), ctx.get());
+    dut->reset = 0;
+#ifdef TB_PUBLIC
+    // Public build: load the three bcdcount digits, and the enables derived
+    // from them, which the next clock edge reads.
+    const uint32_t first = static_cast<uint32_t>(r.first);
+    dut->rootp->top_module__DOT__counter0__DOT__q = first % 10u;
+    dut->rootp->top_module__DOT__counter1__DOT__q = first / 10u % 10u;
+    dut->rootp->top_module__DOT__counter2__DOT__q = first / 100u;
+    dut->rootp->top_module__DOT__q0 = first % 10u;
+    dut->rootp->top_module__DOT__q1 = first / 10u % 10u;
+    dut->rootp->top_module__DOT__q2 = first / 100u;
+    dut->rootp->top_module__DOT__c_enable = enables(first) & 7u;
+    dut->c_enable = enables(first) & 7u;
+    dut->OneHertz = enables(first) >> 3;
+    dut->eval();
+#else
+    if (r.first != 0) {
+        std::cerr << "[TB] dut_104 state injection needs a PUBLIC=1 build" << std::endl;
+        return false;
+    }
+#endif
+
+    for (uint64_t s = r.first; s < r.last; ++s) {
+        tick(dut.get(), ctx.get());
+        ++visits[s];
+        const uint32_t n = static_cast<uint32_t>((s + 1u) % kStates);
+        const uint8_t got = static_cast<uint8_t>(dut->c_enable | (dut->OneHertz << 3));
+        if (got != enables(n)) {
+            std::cerr << "[TB] dut_104 range " << r.worker << " failed out of count " << s
+                      << ": expected c_enable=" << int(enables(n) & 7u) << " OneHertz="
+                      << int(enables(n) >> 3) << " got c_enable=" << int(dut->c_enable)
+                      << " OneHertz=" << int(dut->OneHertz) << std::endl;
+            return false;
+        }
+        for (unsigned b = 0; b < 4u; ++b) {
+            asserted[b] += (got >> b) & 1u;
+        }
+    }
+    return true;
+}
+
+// All 1,000 counts split into `workers` ranges; c_enable[0..2] and OneHertz
+// must assert 1000, 100, 10 and 1 times.
+static tb::StateRangeRun exhaustive(unsigned workers) {
+    std::vector<std::array<uint64_t, 4>> asserted(workers, std::array<uint64_t, 4>{});
+    tb::StateRangeRun run = tb::run_state_ranges(
+        "dut_104", workers, kStates,
+        [&](const tb::StateRange &r, std::vector<uint8_t> &visits) {
+            return run_range(r, visits, asserted[r.worker]);
+        });
+    static const uint64_t kExpected[4] = {kStates, kStates / 10u, kStates / 100u, 1u};
+    static const char *const kNames[4] = {"c_enable[0]", "c_enable[1]", "c_enable[2]", "OneHertz"};
+    for (unsigned b = 0; b < 4u && run.ok; ++b) {
+        uint64_t total = 0;
+        for (const auto &a : asserted) {
+            total += a[b];
+        }
+        if (total != kExpected[b]) {
+            std::cerr << "[TB] dut_104 " << kNames[b] << " asserted " << total << " times, expected "
+                      << kExpected[b] << std::endl;
+            run.ok = false;
+        }
+    }
+    return run;
+}
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_104>(ctx.get());
@@ -73,6 +165,27 @@ int main(int argc, char **argv) {
         }
     }
 
+    // +exhaustive: every count checked once, serially and split across
+    // +threads=<n> ranges (state injection needs PUBLIC=1).
+    if (tb::plusarg_flag(ctx.get(), "exhaustive")) {
+#ifdef TB_PUBLIC
+        const unsigned workers = tb::worker_count(ctx.get());
+#else
+        const unsigned workers = 1u;
+        std::cout << "[TB] dut_104 exhaustive: no state injection without PUBLIC=1, running serially"
+                  << std::endl;
+#endif
+        const tb::StateRangeRun serial = exhaustive(1u);
+        if (!serial.ok) {
+            return EXIT_FAILURE;
+        }
+        const tb::StateRangeRun parallel = workers > 1u ? exhaustive(workers) : serial;
+        if (!parallel.ok) {
+            return EXIT_FAILURE;
+        }
+        tb::report_state_ranges("dut_104", kStates, serial, parallel);
+    }
+
     std::cout << "[TB] dut_104 passed: cascaded BCD enables and OneHertz pulse" << std::endl;
 
 #if VM_COVERAGE
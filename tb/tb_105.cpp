@@ -1,11 +1,20 @@
+#include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_105.h"
+#ifdef TB_PUBLIC
+#include "Vdut_105___024root.h"
+#endif
+#include "lib/state_ranges.h"
+#include "lib/tb_harness.h"
+
+static constexpr uint32_t kStates = 10000;
 
 static inline void tick(Vdut_105 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -16,9 +25,87 @@ static inline void tick(Vdut_105 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+static inline uint16_t to_bcd(uint32_t n) {
+    return static_cast<uint16_t>((n % 10u) | ((n / 10u % 10u) << 4) | ((n / 100u % 10u) << 8)
+                                 | ((n / 1000u) << 12));
+}
+
+// Carry enables registered with count n: digits below ena[i] all 9.
+static inline uint8_t enables(uint32_t n) {
+    return static_cast<uint8_t>((n % 10u == 9u ? 1u : 0u) | (n % 100u == 99u ? 2u : 0u)
+                                | (n % 1000u == 999u ? 4u : 0u));
+}
+
+// One clock out of every count in [r.first, r.last) on a model of its own,
+// counting the ena[3:1] assertions per bit.
+static bool run_range(const tb::StateRange &r, std::vector<uint8_t> &visits,
+                      std::array<uint64_t, 3> &asserted) {
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->traceEverOn(false);
+    auto dut = std::make_unique<Vdut_105>(ctx.get());
+    dut->clk = 0;
+    dut->reset = 1;
+    tick(dut.get(), ctx.get());
+    dut->reset = 0;
+#ifdef TB_PUBLIC
+    // Public build: q and ena are the whole state, load the first count. Both
+    // are output regs, so the storage is the internal signal.
+    dut->rootp->top_module__DOT__q = to_bcd(static_cast<uint32_t>(r.first));
+    dut->rootp->top_module__DOT__ena = enables(static_cast<uint32_t>(r.first));
+    dut->eval();
+#else
+    if (r.first != 0) {
+        std::cerr << "[TB] dut_105 state injection needs a PUBLIC=1 build" << std::endl;
+        return false;
+    }
+#endif
+
+    for (uint64_t s = r.first; s < r.last; ++s) {
+        tick(dut.get(), ctx.get());
+        ++visits[s];
+        const uint32_t n = static_cast<uint32_t>((s + 1u) % kStates);
+        const uint8_t ena = static_cast<uint8_t>(dut->ena);
+        if (dut->q != to_bcd(n) || ena != enables(n)) {
+            std::cerr << "[TB] dut_105 range " << r.worker << " failed out of count " << s
+                      << ": expected q=0x" << std::hex << to_bcd(n) << " ena=0x" << int(enables(n))
+                      << " got q=0x" << int(dut->q) << " ena=0x" << int(ena) << std::dec << std::endl;
+            return false;
+        }
+        for (unsigned b = 0; b < 3u; ++b) {
+            asserted[b] += (ena >> b) & 1u;
+        }
+    }
+    return true;
+}
+
+// All 10,000 counts split into `workers` ranges; ena[1], ena[2] and ena[3]
+// must each assert once per count ending in 9, 99 and 999.
+static tb::StateRangeRun exhaustive(unsigned workers) {
+    std::vector<std::array<uint64_t, 3>> asserted(workers, std::array<uint64_t, 3>{});
+    tb::StateRangeRun run = tb::run_state_ranges(
+        "dut_105", workers, kStates,
+        [&](const tb::StateRange &r, std::vector<uint8_t> &visits) {
+            return run_range(r, visits, asserted[r.worker]);
+        });
+    static const uint64_t kExpected[3] = {kStates / 10u, kStates / 100u, kStates / 1000u};
+    for (unsigned b = 0; b < 3u && run.ok; ++b) {
+        uint64_t total = 0;
+        for (const auto &a : asserted) {
+            total += a[b];
+        }
+        if (total != kExpected[b]) {
+            std::cerr << "[TB] dut_105 ena[" << b + 1u << "] asserted " << total << " times, expected "
+                      << kExpected[b] << std::endl;
+            run.ok = false;
+        }
+    }
+    return run;
+}
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_105>(ctx.get());
@@ -89,6 +176,27 @@ int main(int argc, char **argv) {
         }
     }
 
+    // +exhaustive: every count checked once, serially and split across
+    // +threads=<n> ranges (state injection needs PUBLIC=1).
+    if (tb::plusarg_flag(ctx.get(), "exhaustive")) {
+#ifdef TB_PUBLIC
+        const unsigned workers = tb::worker_count(ctx.get());
+#else
+        const unsigned workers = 1u;
+        std::cout << "[TB] dut_105 exhaustive: no state injection without PUBLIC=1, running serially"
+                  << std::endl;
+#endif
+        const tb::StateRangeRun serial = exhaustive(1u);
+        if (!serial.ok) {
+            return EXIT_FAILURE;
+        }
+        const tb::StateRangeRun parallel = workers > 1u ? exhaustive(workers) : serial;
+        if (!parallel.ok) {
+            return EXIT_FAILURE;
+        }
+        tb::report_state_ranges("dut_105", kStates, serial, parallel);
+    }
+
     std::cout << "[TB] dut_105 passed: 4-digit BCD counter with enables" << std::endl;
 
 #if VM_COVERAGE
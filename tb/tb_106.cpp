@@ -6,6 +6,16 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_106.h"
+#ifdef TB_PUBLIC
+#include "Vdut_106___024root.h"
+#endif
+#include "lib/tb_harness.h"
+
+// Cycles of the original 13-hour sweep, the baseline for the cycle reduction.
+static constexpr uint64_t kSweepCycles = 60 * 60 * 13;
+static constexpr uint32_t kDaySeconds = 24 * 60 * 60;
+// Simulated seconds before and after each rollover in fast-forward mode.
+static constexpr uint32_t kWindow = 12;
 
 static inline void tick(Vdut_106 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -16,61 +26,170 @@ static inline void tick(Vdut_106 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+static inline uint8_t bcd(uint32_t v) {
+    return static_cast<uint8_t>(((v / 10u) << 4) | (v % 10u));
+}
+
+// Reference clock: BCD hh (01..12), mm, ss and the pm flag.
+struct ClockModel {
+    uint8_t pm;
+    uint8_t hh;
+    uint8_t mm;
+    uint8_t ss;
+
+    // The time `t` seconds after 12:00:00 AM.
+    static ClockModel at(uint32_t t) {
+        t %= kDaySeconds;
+        const uint32_t h24 = t / 3600u;
+        const uint32_t h12 = h24 % 12u == 0u ? 12u : h24 % 12u;
+        return ClockModel{static_cast<uint8_t>(h24 >= 12u), bcd(h12), bcd((t / 60u) % 60u), bcd(t % 60u)};
+    }
+
+    uint32_t seconds() const {
+        const uint32_t h = (hh >> 4) * 10u + (hh & 15u);
+        return (pm ? 12u : 0u) * 3600u + (h % 12u) * 3600u + ((mm >> 4) * 10u + (mm & 15u)) * 60u
+             + (ss >> 4) * 10u + (ss & 15u);
+    }
+
+    void tick(bool ena) {
+        if (ena) {
+            *this = at(seconds() + 1u);
+        }
+    }
+};
+
+static bool check(const Vdut_106 *dut, const ClockModel &m, const char *phase, uint64_t cycle) {
+    if (dut->hh == m.hh && dut->mm == m.mm && dut->ss == m.ss && dut->pm == m.pm) {
+        return true;
+    }
+    std::cerr << "[TB] dut_106 failed (" << phase << ", cycle " << cycle << "): expected "
+              << std::hex << int(m.hh) << ":" << int(m.mm) << ":" << int(m.ss)
+              << (m.pm ? " PM" : " AM") << ", got " << int(dut->hh) << ":" << int(dut->mm) << ":"
+              << int(dut->ss) << (dut->pm ? " PM" : " AM") << std::dec << std::endl;
+    return false;
+}
+
+#ifdef TB_PUBLIC
+// Public build: load the time straight into the hh/pm output registers, the
+// two count60 counters and the mm/ss nets they drive, which ena_hms reads.
+// The ports are only copies of these, refreshed on eval.
+static void load_time(Vdut_106 *dut, const ClockModel &m) {
+    dut->rootp->top_module__DOT__hh = m.hh;
+    dut->rootp->top_module__DOT__pm = m.pm;
+    dut->rootp->top_module__DOT__count_mm__DOT__q = m.mm;
+    dut->rootp->top_module__DOT__count_ss__DOT__q = m.ss;
+    dut->rootp->top_module__DOT__mm = m.mm;
+    dut->rootp->top_module__DOT__ss = m.ss;
+    dut->eval();
+}
+#endif
+
+// Every second from reset until the clock has advanced `seconds` seconds,
+// with ena held low one cycle in 97 to check that the time holds. Held
+// cycles do not count, so the sweep really covers `seconds` seconds; the
+// cycles it took go to `cycles_run`.
+static bool full_sweep(Vdut_106 *dut, VerilatedContext *ctx, uint64_t seconds, uint64_t *cycles_run = nullptr) {
+    dut->reset = 1;
+    dut->ena = 0;
+    tick(dut, ctx);
+    dut->reset = 0;
+    ClockModel m = ClockModel::at(0);
+    if (!check(dut, m, "reset", 0)) {
+        return false;
+    }
+    uint64_t cycle = 0;
+    for (uint64_t advanced = 0; advanced < seconds;) {
+        ++cycle;
+        const bool ena = cycle % 97u != 0u;
+        dut->ena = ena;
+        tick(dut, ctx);
+        m.tick(ena);
+        advanced += ena ? 1u : 0u;
+        if (!check(dut, m, "sweep", cycle)) {
+            return false;
+        }
+    }
+    if (cycles_run != nullptr) {
+        *cycles_run = cycle;
+    }
+    return true;
+}
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_106>(ctx.get());
-
-    uint8_t pm_model = 0;
-    uint8_t hh_model = 0x12u;
-
     dut->clk = 0;
     dut->reset = 1;
     dut->ena = 0;
     dut->eval();
 
-    // Simulate enough seconds to cover all hour transitions including
-    // 09->10 and 11->12, which exercise the hh[3:0]==9 branch and PM toggle.
-    const int cycles = 60 * 60 * 13; // 13 hours of 1-second ticks
-    for (int cycle = 0; cycle < cycles; ++cycle) {
-        if (cycle == 1) {
-            dut->reset = 0;
-        }
-
-        dut->ena = 1;
-        tick(dut.get(), ctx.get());
-
-        // We will only check that hh and pm stay in valid ranges and toggle occasionally.
-        uint8_t hh = dut->hh;
-        uint8_t pm = dut->pm;
-
-        if (!(hh >= 0x01 && hh <= 0x12)) {
-            std::cerr << "[TB] dut_106 failed: invalid hour encoding 0x"
-                      << std::hex << int(hh) << std::dec << std::endl;
+    // +full_sweep (nightly): every second of a whole day, both pm flips and
+    // the 11:59:59 PM -> 12:00:00 AM rollover at the end.
+    if (tb::plusarg_flag(ctx.get(), "full_sweep")) {
+        tb::Stopwatch sw;
+        uint64_t cycles = 0;
+        if (!full_sweep(dut.get(), ctx.get(), kDaySeconds, &cycles)) {
             return EXIT_FAILURE;
         }
+        tb::report_rate("dut_106", "full sweep cycles", double(cycles), sw.seconds(), "cyc");
+    }
 
-        if (pm > 1u) {
-            std::cerr << "[TB] dut_106 failed: pm not 0/1: " << int(pm) << std::endl;
-            return EXIT_FAILURE;
+#ifdef TB_PUBLIC
+    // Fast-forward: reset once, then jump to kWindow seconds before each
+    // rollover and simulate across it. The targets are all 24 hour
+    // rollovers (12->01, 09->10, 11->12 with pm flipping, in AM and PM; each
+    // also rolls mm and ss over) and two minute rollovers for the mm tens
+    // digit. The window spans ss x9->(x+1)0 for the ss tens digit.
+    static const uint32_t kMinuteTargets[] = {1u * 3600u + 10u * 60u, 14u * 3600u + 30u * 60u};
+    tb::Stopwatch sw;
+    if (!full_sweep(dut.get(), ctx.get(), 2)) {
+        return EXIT_FAILURE;
+    }
+    uint64_t cycles = 3;
+    unsigned windows = 0;
+    auto window = [&](uint32_t target) {
+        ClockModel m = ClockModel::at(target + kDaySeconds - kWindow);
+        load_time(dut.get(), m);
+        if (!check(dut.get(), m, "load", cycles)) {
+            return false;
         }
-
-        // Basic sanity: on reset, hh must be 0x12 and pm=0.
-        if (cycle < 2) {
-            if (hh != 0x12u || pm != 0u) {
-                std::cerr << "[TB] dut_106 reset state wrong: hh=0x"
-                          << std::hex << int(hh) << " pm=" << std::dec << int(pm) << std::endl;
-                return EXIT_FAILURE;
+        for (uint32_t i = 0; i < 2u * kWindow; ++i, ++cycles) {
+            const bool ena = i != kWindow / 2u;
+            dut->ena = ena;
+            tick(dut.get(), ctx.get());
+            m.tick(ena);
+            if (!check(dut.get(), m, "fast-forward", cycles)) {
+                return false;
             }
         }
-
-        hh_model = hh;
-        pm_model = pm;
+        ++windows;
+        return true;
+    };
+    for (uint32_t h = 0; h < 24u; ++h) {
+        if (!window(h * 3600u)) {
+            return EXIT_FAILURE;
+        }
     }
+    for (uint32_t t : kMinuteTargets) {
+        if (!window(t)) {
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "[TB] dut_106 fast-forward: " << windows << " rollover windows in " << cycles
+              << " cycles instead of " << kSweepCycles << " (" << double(kSweepCycles) / double(cycles)
+              << "x fewer), " << sw.seconds() << " s" << std::endl;
+#else
+    // Registers are not writable without PUBLIC=1: step the 13 hours.
+    if (!full_sweep(dut.get(), ctx.get(), kSweepCycles)) {
+        return EXIT_FAILURE;
+    }
+#endif
 
-    std::cout << "[TB] dut_106 passed: basic 12-hour clock sanity checks" << std::endl;
+    std::cout << "[TB] dut_106 passed: 12-hour clock matches the reference at every checked second" << std::endl;
 
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
@@ -6,6 +6,8 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_107.h"
+#include "lib/counter_soak.h"
+#include "lib/reset_stress.h"
 
 struct Stim107 {
     uint8_t areset;
@@ -23,9 +25,22 @@ static inline void tick(Vdut_107 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "q=0";
+    static void reset(Vdut_107 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_107 *dut, uint64_t bits) {
+        dut->load = (bits & 7u) == 0u;
+        dut->ena = (bits >> 3) & 1u;
+        dut->data = (bits >> 4) & 15u;
+    }
+    static bool in_reset(const Vdut_107 *dut) { return dut->q == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_107>(ctx.get());
@@ -76,6 +91,39 @@ int main(int argc, char **argv) {
         }
     }
 
+    // +soak=<cycles>: long run against the closed-form reference (lib/counter_soak.h).
+    const tb::SoakConfig soak = tb::SoakConfig::from_plusargs(ctx.get());
+    if (soak.cycles != 0u) {
+        const bool ok = tb::run_counter_soak(
+            "dut_107", soak, 17u, 107u,
+            [&](uint64_t, bool event, uint32_t value, bool ena) {
+                // value 16: areset pulse before the edge, else load `value`
+                if (event && value == 16u) {
+                    dut->areset = 1;
+                    dut->eval();
+                    dut->areset = 0;
+                }
+                dut->load = event && value != 16u;
+                dut->data = static_cast<uint8_t>(value & 15u);
+                dut->ena = ena;
+                tick(dut.get(), ctx.get());
+                return uint32_t(dut->q);
+            },
+            // q is the loaded value (0 after areset) shifted right once per
+            // ena edge since
+            [&](const tb::CounterEvent &e, uint64_t n) {
+                const uint64_t shifts = tb::enabled_edges(e.cycle, n, soak.ena_period);
+                return shifts >= 4u ? 0u : uint32_t((e.value & 15u) >> shifts);
+            });
+        if (!ok) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!tb::run_reset_stress<Vdut_107, ResetTarget>(ctx.get(), "dut_107")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_107 passed: loadable right shift register with async reset" << std::endl;
 
 #if VM_COVERAGE
@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_119.h"
+#include "lib/reset_stress.h"
 
 struct Stim119 {
     uint8_t areset;
@@ -21,9 +22,18 @@ static inline void tick(Vdut_119 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "out=1 (state B)";
+    static void reset(Vdut_119 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_119 *dut, uint64_t bits) { dut->in = bits & 1u; }
+    static bool in_reset(const Vdut_119 *dut) { return dut->out == 1u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_119>(ctx.get());
@@ -71,6 +81,10 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (!tb::run_reset_stress<Vdut_119, ResetTarget>(ctx.get(), "dut_119")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_119 passed: 2-state FSM with async reset" << std::endl;
 
 #if VM_COVERAGE
@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_121.h"
+#include "lib/reset_stress.h"
 
 struct Stim121 {
     uint8_t areset;
@@ -22,9 +23,21 @@ static inline void tick(Vdut_121 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "out=0 (state OFF)";
+    static void reset(Vdut_121 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_121 *dut, uint64_t bits) {
+        dut->j = bits & 1u;
+        dut->k = (bits >> 1) & 1u;
+    }
+    static bool in_reset(const Vdut_121 *dut) { return dut->out == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_121>(ctx.get());
@@ -75,6 +88,10 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (!tb::run_reset_stress<Vdut_121, ResetTarget>(ctx.get(), "dut_121")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_121 passed: JK latch FSM with async reset" << std::endl;
 
 #if VM_COVERAGE
@@ -6,24 +6,45 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_125.h"
+#include "lib/reset_stress.h"
+#ifdef TB_FSM_COV
+#include "Vdut_125___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
 
 struct Stim125 {
     uint8_t areset;
     uint8_t in;
 };
 
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(3);   // 3-bit `state`
+#endif
+
 static inline void tick(Vdut_125 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
     dut->eval();
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "out=0 (state A)";
+    static void reset(Vdut_125 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_125 *dut, uint64_t bits) { dut->in = bits & 1u; }
+    static bool in_reset(const Vdut_125 *dut) { return dut->out == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_125>(ctx.get());
@@ -75,8 +96,16 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (!tb::run_reset_stress<Vdut_125, ResetTarget>(ctx.get(), "dut_125")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_125 passed: 4-state FSM with async reset" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_125", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
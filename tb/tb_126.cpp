@@ -6,18 +6,29 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_126.h"
+#ifdef TB_FSM_COV
+#include "Vdut_126___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
 
 struct Stim126 {
     uint8_t reset;
     uint8_t in;
 };
 
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(3);   // 3-bit `state`
+#endif
+
 static inline void tick(Vdut_126 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
     dut->eval();
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
@@ -77,6 +88,10 @@ int main(int argc, char **argv) {
 
     std::cout << "[TB] dut_126 passed: 4-state FSM with sync reset" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_126", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
@@ -6,6 +6,15 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_128.h"
+#include "lib/reset_stress.h"
+#ifdef TB_FSM_COV
+#include "Vdut_128___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(1);   // 1-bit `state`
+#endif
 
 static inline void tick(Vdut_128 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,12 +22,27 @@ static inline void tick(Vdut_128 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "walk_left=1 walk_right=0";
+    static void reset(Vdut_128 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_128 *dut, uint64_t bits) {
+        dut->bump_left = bits & 1u;
+        dut->bump_right = (bits >> 1) & 1u;
+    }
+    static bool in_reset(const Vdut_128 *dut) { return dut->walk_left == 1u && dut->walk_right == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_128>(ctx.get());
@@ -72,8 +96,16 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (!tb::run_reset_stress<Vdut_128, ResetTarget>(ctx.get(), "dut_128")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_128 passed: basic Lemmings left/right FSM" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_128", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
@@ -6,6 +6,15 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_130.h"
+#include "lib/reset_stress.h"
+#ifdef TB_FSM_COV
+#include "Vdut_130___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(3);   // 3-bit `state`
+#endif
 
 static inline void tick(Vdut_130 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,12 +22,32 @@ static inline void tick(Vdut_130 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "walk_left=1, walk_right/aaah/digging=0";
+    static void reset(Vdut_130 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_130 *dut, uint64_t bits) {
+        dut->bump_left = bits & 1u;
+        dut->bump_right = (bits >> 1) & 1u;
+        dut->ground = (bits >> 2) & 1u;
+        dut->dig = (bits >> 3) & 1u;
+    }
+    static bool in_reset(const Vdut_130 *dut) {
+        return dut->walk_left == 1u && dut->walk_right == 0u
+            && dut->aaah == 0u && dut->digging == 0u;
+    }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_130>(ctx.get());
@@ -132,8 +161,16 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (!tb::run_reset_stress<Vdut_130, ResetTarget>(ctx.get(), "dut_130")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_130 passed: extended Lemmings walk/fall/dig FSM" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_130", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
@@ -6,6 +6,24 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_132.h"
+#include "lib/onehot_equiv.h"
+
+// Binary-encoded reference: next state index for in=0/1, out1 in S8/S9,
+// out2 in S7/S9. Result bits: next_state[9:0], out1 (10), out2 (11).
+static const uint8_t kNext[10][2] = {
+    {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5}, {8, 6}, {9, 7}, {0, 7}, {0, 1}, {0, 1},
+};
+
+static tb::OneHotReference reference() {
+    tb::OneHotReference ref{10, 1, 12, 0x3FFu, std::vector<uint32_t>(20)};
+    for (unsigned s = 0; s < 10; ++s) {
+        for (unsigned in = 0; in < 2; ++in) {
+            ref.table[(s << 1) | in] = (1u << kNext[s][in]) | ((s == 8 || s == 9) ? 1u << 10 : 0u)
+                                     | ((s == 7 || s == 9) ? 1u << 11 : 0u);
+        }
+    }
+    return ref;
+}
 
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
@@ -51,6 +69,20 @@ int main(int argc, char **argv) {
         }
     }
 
+    // Every state vector x in: legal one-hot states against the binary
+    // reference, the rest reported.
+    const tb::OneHotReference ref = reference();
+    tb::OneHotEquivStats equiv;
+    if (!tb::check_onehot_equivalence("dut_132", ref, [&](uint32_t state, uint32_t in) {
+            dut->state = static_cast<uint16_t>(state);
+            dut->in = static_cast<uint8_t>(in);
+            dut->eval();
+            return uint32_t(dut->next_state) | (uint32_t(dut->out1) << 10) | (uint32_t(dut->out2) << 11);
+        }, equiv)) {
+        return EXIT_FAILURE;
+    }
+    tb::report_onehot_equivalence("dut_132", ref, equiv);
+
     std::cout << "[TB] dut_132 passed: next-state and outputs combinational block" << std::endl;
 
 #if VM_COVERAGE
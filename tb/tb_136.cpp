@@ -6,6 +6,15 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_136.h"
+#ifdef TB_FSM_COV
+#include "Vdut_136___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+#include "lib/serial_stream.h"
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(3);   // 3-bit `state`
+#endif
 
 static inline void tick(Vdut_136 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,6 +22,9 @@ static inline void tick(Vdut_136 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
@@ -61,6 +73,7 @@ static void send_bad_frame_check(Vdut_136 *dut, VerilatedContext *ctx, uint8_t d
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_136>(ctx.get());
@@ -103,8 +116,40 @@ int main(int argc, char **argv) {
     send_good_frame_check(dut.get(), ctx.get(), 0x0Fu);
     send_good_frame_check(dut.get(), ctx.get(), 0xF0u);
 
+    // Streaming run: 4 KiB with 1% framing errors by default. +stream uses
+    // 1 MiB (+bytes=<n>) or a memory-mapped +infile=<path> and reports
+    // received bytes/sec and error-recovery latency.
+    {
+        const bool stream = tb::plusarg_flag(ctx.get(), "stream");
+        tb::ByteSource src(ctx.get(), stream ? (1u << 20) : 4096u, 136);
+        tb::SerialConfig cfg;
+        cfg.frame_err_ppm = 10000;
+        cfg.idle_max = 2;
+        cfg.seed = 136;
+        cfg.from_plusargs(ctx.get());
+
+        dut->reset = 1;
+        dut->in = 1;
+        tick(dut.get(), ctx.get());
+        dut->reset = 0;
+
+        tb::SerialResult res;
+        if (!src.ok() ||
+            !tb::run_serial_stream(dut.get(), ctx.get(), "dut_136", src.data(), src.size(), cfg,
+                                   tick, [](Vdut_136 *d) { return int(d->out_byte); }, res)) {
+            return EXIT_FAILURE;
+        }
+        if (stream) {
+            tb::report_serial("dut_136", res);
+        }
+    }
+
     std::cout << "[TB] dut_136 passed: serial receiver with data latch and full coverage patterns" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_136", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
@@ -6,6 +6,18 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_138.h"
+#ifdef TB_FSM_COV
+#include "Vdut_138___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+#ifdef TB_PUBLIC
+#include "Vdut_138___024root.h"
+#endif
+#include "lib/fsm_explore.h"
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(4);   // 4-bit `state`
+#endif
 
 static inline void tick(Vdut_138 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,12 +25,16 @@ static inline void tick(Vdut_138 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_138>(ctx.get());
@@ -94,74 +110,105 @@ int main(int argc, char **argv) {
         check_outputs(ctx_str);
     };
 
-    // Phase 1: reset and sanity check (stay in NONE on zeros, no outputs asserted).
-    apply_reset();
-    step(0, "phase1.none_0");
-    step(0, "phase1.none_0_again");
-
-    // Phase 2: exercise DISC and both outgoing transitions from DISC.
-    // Pattern: 0 1 1 1 1 1 0 -> DISC, then 0 (DISC->NONE), then another DISC with 1 (DISC->ONE).
-    apply_reset();
-    step(0, "disc.seq.none0");
-    step(1, "disc.seq.one");
-    step(1, "disc.seq.two");
-    step(1, "disc.seq.three");
-    step(1, "disc.seq.four");
-    step(1, "disc.seq.five");
-    step(0, "disc.seq.enter_disc");  // reach DISC, disc should be 1
-    step(0, "disc.seq.disc_to_none"); // DISC with in=0
-
-    // Second time: go to DISC again and take in=1 branch.
-    apply_reset();
-    step(0, "disc2.seq.none0");
-    step(1, "disc2.seq.one");
-    step(1, "disc2.seq.two");
-    step(1, "disc2.seq.three");
-    step(1, "disc2.seq.four");
-    step(1, "disc2.seq.five");
-    step(0, "disc2.seq.enter_disc");  // DISC
-    step(1, "disc2.seq.disc_to_one"); // DISC with in=1
-
-    // Phase 3: exercise FLAG and both outgoing transitions from FLAG.
-    // Pattern for FLAG: 0 1 1 1 1 1 1 0 (0 followed by six 1s then 0).
-    apply_reset();
-    step(0, "flag.seq.none0");
-    step(1, "flag.seq.one");
-    step(1, "flag.seq.two");
-    step(1, "flag.seq.three");
-    step(1, "flag.seq.four");
-    step(1, "flag.seq.five");
-    step(1, "flag.seq.six");
-    step(0, "flag.seq.enter_flag"); // FLAG
-    step(1, "flag.seq.flag_to_one"); // FLAG with in=1
-
-    // Second time to take FLAG with in=0 branch.
-    apply_reset();
-    step(0, "flag2.seq.none0");
-    step(1, "flag2.seq.one");
-    step(1, "flag2.seq.two");
-    step(1, "flag2.seq.three");
-    step(1, "flag2.seq.four");
-    step(1, "flag2.seq.five");
-    step(1, "flag2.seq.six");
-    step(0, "flag2.seq.enter_flag"); // FLAG
-    step(0, "flag2.seq.flag_to_none"); // FLAG with in=0
-
-    // Phase 4: exercise ERR and both outgoing transitions from ERR.
-    // Pattern for ERR: seven 1s (from NONE).
-    apply_reset();
-    step(1, "err.seq.one");
-    step(1, "err.seq.two");
-    step(1, "err.seq.three");
-    step(1, "err.seq.four");
-    step(1, "err.seq.five");
-    step(1, "err.seq.six");
-    step(1, "err.seq.enter_err");  // reach ERR
-    step(1, "err.seq.err_stay_err"); // ERR with in=1
-    step(0, "err.seq.err_to_none");   // ERR with in=0
+    // Cover replay (the default run) and +fsm_explore (lib/fsm_explore.h): the full state is
+    // just the state register.
+    tb::FsmHooks hooks;
+    hooks.reset = apply_reset;
+    hooks.step = [&](uint32_t in) { step(static_cast<uint8_t>(in), "fsm"); };
+    hooks.key = [&]() -> uint64_t {
+#ifdef TB_PUBLIC
+        return dut->rootp->top_module__DOT__state;
+#else
+        return state;
+#endif
+    };
+    hooks.state = [](uint64_t key) { return static_cast<unsigned>(key); };
+#ifdef TB_PUBLIC
+    hooks.restore = [&](uint64_t key) {
+        dut->rootp->top_module__DOT__state = static_cast<uint8_t>(key);
+        dut->eval();
+        state = static_cast<uint8_t>(key);
+        return true;
+    };
+#endif
+    const tb::FsmMode mode = tb::run_fsm_modes(ctx.get(), "dut_138", hooks, 1);
+    if (mode == tb::FsmMode::Failed) {
+        return EXIT_FAILURE;
+    }
+    if (mode == tb::FsmMode::Scripted) {
+        // Phase 1: reset and sanity check (stay in NONE on zeros, no outputs asserted).
+        apply_reset();
+        step(0, "phase1.none_0");
+        step(0, "phase1.none_0_again");
+
+        // Phase 2: exercise DISC and both outgoing transitions from DISC.
+        // Pattern: 0 1 1 1 1 1 0 -> DISC, then 0 (DISC->NONE), then another DISC with 1 (DISC->ONE).
+        apply_reset();
+        step(0, "disc.seq.none0");
+        step(1, "disc.seq.one");
+        step(1, "disc.seq.two");
+        step(1, "disc.seq.three");
+        step(1, "disc.seq.four");
+        step(1, "disc.seq.five");
+        step(0, "disc.seq.enter_disc");  // reach DISC, disc should be 1
+        step(0, "disc.seq.disc_to_none"); // DISC with in=0
+
+        // Second time: go to DISC again and take in=1 branch.
+        apply_reset();
+        step(0, "disc2.seq.none0");
+        step(1, "disc2.seq.one");
+        step(1, "disc2.seq.two");
+        step(1, "disc2.seq.three");
+        step(1, "disc2.seq.four");
+        step(1, "disc2.seq.five");
+        step(0, "disc2.seq.enter_disc");  // DISC
+        step(1, "disc2.seq.disc_to_one"); // DISC with in=1
+
+        // Phase 3: exercise FLAG and both outgoing transitions from FLAG.
+        // Pattern for FLAG: 0 1 1 1 1 1 1 0 (0 followed by six 1s then 0).
+        apply_reset();
+        step(0, "flag.seq.none0");
+        step(1, "flag.seq.one");
+        step(1, "flag.seq.two");
+        step(1, "flag.seq.three");
+        step(1, "flag.seq.four");
+        step(1, "flag.seq.five");
+        step(1, "flag.seq.six");
+        step(0, "flag.seq.enter_flag"); // FLAG
+        step(1, "flag.seq.flag_to_one"); // FLAG with in=1
+
+        // Second time to take FLAG with in=0 branch.
+        apply_reset();
+        step(0, "flag2.seq.none0");
+        step(1, "flag2.seq.one");
+        step(1, "flag2.seq.two");
+        step(1, "flag2.seq.three");
+        step(1, "flag2.seq.four");
+        step(1, "flag2.seq.five");
+        step(1, "flag2.seq.six");
+        step(0, "flag2.seq.enter_flag"); // FLAG
+        step(0, "flag2.seq.flag_to_none"); // FLAG with in=0
+
+        // Phase 4: exercise ERR and both outgoing transitions from ERR.
+        // Pattern for ERR: seven 1s (from NONE).
+        apply_reset();
+        step(1, "err.seq.one");
+        step(1, "err.seq.two");
+        step(1, "err.seq.three");
+        step(1, "err.seq.four");
+        step(1, "err.seq.five");
+        step(1, "err.seq.six");
+        step(1, "err.seq.enter_err");  // reach ERR
+        step(1, "err.seq.err_stay_err"); // ERR with in=1
+        step(0, "err.seq.err_to_none");   // ERR with in=0
+    }
 
     std::cout << "[TB] dut_138 passed: HDLC flag/disc/err pattern FSM with full coverage" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_138", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
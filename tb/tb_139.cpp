@@ -6,10 +6,26 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_139.h"
+#include "lib/reset_stress.h"
+#ifdef TB_FSM_COV
+#include "Vdut_139___024root.h"
+#include "lib/fsm_coverage.h"
+
+static tb::FsmTransitionMatrix fsm_cov(2);   // 2-bit `state`
+#endif
+
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "z=0 (state IDLE)";
+    static void reset(Vdut_139 *dut, bool on) { dut->aresetn = !on; }
+    static void inputs(Vdut_139 *dut, uint64_t bits) { dut->x = bits & 1u; }
+    static bool in_reset(const Vdut_139 *dut) { return dut->z == 0u; }
+};
 
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_139>(ctx.get());
@@ -28,6 +44,9 @@ int main(int argc, char **argv) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
     state = IDLE;
     dut->aresetn = 1;
@@ -51,6 +70,9 @@ int main(int argc, char **argv) {
         // Advance clock to update DUT state (we don't re-check z here).
         dut->clk = 1;
         dut->eval();
+#ifdef TB_FSM_COV
+        fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
         ctx->timeInc(1);
     };
 
@@ -66,6 +88,9 @@ int main(int argc, char **argv) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
     state = IDLE;
     dut->aresetn = 1;
@@ -74,8 +99,16 @@ int main(int argc, char **argv) {
     const uint8_t seq2[] = {0,1,0,1,0};
     for (uint8_t b : seq2) step(b);
 
+    if (!tb::run_reset_stress<Vdut_139, ResetTarget>(ctx.get(), "dut_139")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_139 passed: overlapping 101 detector FSM" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_139", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
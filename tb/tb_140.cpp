@@ -6,6 +6,15 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_140.h"
+#include "lib/reset_stress.h"
+#ifdef TB_FSM_COV
+#include "Vdut_140___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(2);   // 2-bit `state`
+#endif
 
 static inline void tick(Vdut_140 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,12 +22,24 @@ static inline void tick(Vdut_140 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "z=0 (state A)";
+    static void reset(Vdut_140 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_140 *dut, uint64_t bits) { dut->x = bits & 1u; }
+    static bool in_reset(const Vdut_140 *dut) { return dut->z == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_140>(ctx.get());
@@ -57,8 +78,16 @@ int main(int argc, char **argv) {
     const uint8_t seq[] = {0,1,1,0,1,0,0,1,1,1};
     for (uint8_t b : seq) step(b);
 
+    if (!tb::run_reset_stress<Vdut_140, ResetTarget>(ctx.get(), "dut_140")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_140 passed: 3-state FSM with z on state B" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_140", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
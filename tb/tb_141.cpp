@@ -6,6 +6,15 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_141.h"
+#include "lib/reset_stress.h"
+#ifdef TB_FSM_COV
+#include "Vdut_141___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(2);   // 2-bit `state`
+#endif
 
 static inline void tick(Vdut_141 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,12 +22,24 @@ static inline void tick(Vdut_141 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "z=x (state A)";
+    static void reset(Vdut_141 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_141 *dut, uint64_t bits) { dut->x = bits & 1u; }
+    static bool in_reset(const Vdut_141 *dut) { return dut->z == dut->x; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_141>(ctx.get());
@@ -91,8 +112,16 @@ int main(int argc, char **argv) {
     if (step(1, "A,x=1_second") != EXIT_SUCCESS) return EXIT_FAILURE;
     if (step(0, "B,x=0_second") != EXIT_SUCCESS) return EXIT_FAILURE;
 
+    if (!tb::run_reset_stress<Vdut_141, ResetTarget>(ctx.get(), "dut_141")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_141 passed: simple 2-state FSM with z behavior" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_141", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
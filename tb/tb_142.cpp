@@ -6,6 +6,14 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_142.h"
+#ifdef TB_FSM_COV
+#include "Vdut_142___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(1);   // 1-bit `state`
+#endif
 
 static inline void tick(Vdut_142 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,6 +21,9 @@ static inline void tick(Vdut_142 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
@@ -97,6 +108,10 @@ int main(int argc, char **argv) {
 
     std::cout << "[TB] dut_142 passed: counter-based FSM" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_142", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
@@ -6,6 +6,14 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_147.h"
+#ifdef TB_FSM_COV
+#include "Vdut_147___024root.h"
+#include "lib/fsm_coverage.h"
+#endif
+
+#ifdef TB_FSM_COV
+static tb::FsmTransitionMatrix fsm_cov(3);   // 3-bit `state`
+#endif
 
 static inline void tick(Vdut_147 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -13,6 +21,9 @@ static inline void tick(Vdut_147 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
     dut->clk = 1;
     dut->eval();
+#ifdef TB_FSM_COV
+    fsm_cov.sample(dut->rootp->top_module__DOT__state);
+#endif
     ctx->timeInc(1);
 }
 
@@ -108,6 +119,10 @@ int main(int argc, char **argv) {
 
     std::cout << "[TB] dut_147 passed: 6-state FSM with z on E/F" << std::endl;
 
+#ifdef TB_FSM_COV
+    tb::finish_fsm_coverage("dut_147", fsm_cov);
+#endif
+
 #if VM_COVERAGE
     const char *covPath = std::getenv("VERILATOR_COV_FILE");
     if (covPath == nullptr || covPath[0] == '\0') {
@@ -6,6 +6,10 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_151.h"
+#ifdef TB_PUBLIC
+#include "Vdut_151___024root.h"
+#endif
+#include "lib/fsm_explore.h"
 
 static inline void tick(Vdut_151 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -19,6 +23,7 @@ static inline void tick(Vdut_151 *dut, VerilatedContext *ctx) {
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_151>(ctx.get());
@@ -29,25 +34,22 @@ int main(int argc, char **argv) {
         G1 = 5, G1P = 6, TMP3 = 7, G0P = 8
     };
     int state = A;
+    uint8_t f = 0, g = 0;   // output registers
+
+    // One clock of the RTL: next_state only looks at resetn in A, g1p and
+    // g0p, and f/g are loaded from next_state even while in reset.
+    auto clock = [&](uint8_t x, uint8_t y, uint8_t resetn, const char *ctx_str) {
+        x &= 1u;
+        y &= 1u;
+        resetn &= 1u;
+        dut->x = x;
+        dut->y = y;
+        dut->resetn = resetn;
 
-    auto apply_reset = [&]() {
-        dut->resetn = 0;
-        dut->x = 0;
-        dut->y = 0;
-        tick(dut.get(), ctx.get());
-        state = A;
-        dut->resetn = 1;
-    };
-
-    auto step = [&](uint8_t x, uint8_t y, const char *ctx_str) {
-        dut->x = x & 1u;
-        dut->y = y & 1u;
-
-        // Compute next state (ignoring async reset here; handled in apply_reset).
         int next = state;
         switch (state) {
             case A:
-                next = dut->resetn ? F1 : A;
+                next = resetn ? F1 : A;
                 break;
             case F1:
                 next = TMP0;
@@ -68,93 +70,128 @@ int main(int argc, char **argv) {
                 next = y ? G1P : G0P;
                 break;
             case G1P:
-                next = dut->resetn ? G1P : A;
+                next = resetn ? G1P : A;
                 break;
             case G0P:
-                next = dut->resetn ? G0P : A;
+                next = resetn ? G0P : A;
                 break;
         }
+        switch (next) {
+            case F1:   f = 1; break;
+            case G1:
+            case TMP3:
+            case G1P:  g = 1; break;
+            case G0P:  g = 0; break;
+            default:   f = 0; g = 0; break;
+        }
 
         tick(dut.get(), ctx.get());
-        state = next;
+        state = resetn ? next : A;
 
-        // Expected outputs depend on next_state (as in RTL).
-        uint8_t f_exp = 0;
-        uint8_t g_exp = 0;
-        switch (state) {
-            case F1:  f_exp = 1; g_exp = 0; break;
-            case G1:  f_exp = 0; g_exp = 1; break;
-            case TMP3:g_exp = 1; break;
-            case G1P: g_exp = 1; break;
-            case G0P: g_exp = 0; break;
-            default:  f_exp = 0; g_exp = 0; break;
-        }
-
-        if (dut->f != f_exp || dut->g != g_exp) {
+        if (dut->f != f || dut->g != g) {
             std::cerr << "[TB] dut_151 failed (" << ctx_str
                       << "): state=" << state
-                      << " x=" << int(x) << " y=" << int(y)
-                      << " expected f=" << int(f_exp)
-                      << " g=" << int(g_exp)
+                      << " x=" << int(x) << " y=" << int(y) << " resetn=" << int(resetn)
+                      << " expected f=" << int(f)
+                      << " g=" << int(g)
                       << " got f=" << int(dut->f)
                       << " g=" << int(dut->g) << std::endl;
             std::exit(EXIT_FAILURE);
         }
     };
 
-    // Scenario 1: path to g1p via y=1, exercising g1 and g1p cases.
-    apply_reset();
-    // A -> f1 -> tmp0
-    step(0, 0, "S1.A_to_F1");        // A -> f1
-    step(0, 0, "S1.F1_to_TMP0");     // f1 -> tmp0
-    // tmp0 -> tmp1 -> tmp2
-    step(1, 0, "S1.TMP0_to_TMP1");   // tmp0 -> tmp1
-    step(0, 0, "S1.TMP1_to_TMP2");   // tmp1 -> tmp2
-    // tmp2 -> g1 (x=1), then g1 -> g1p (y=1)
-    step(1, 0, "S1.TMP2_to_G1");     // tmp2 -> g1
-    step(0, 1, "S1.G1_to_G1P");      // g1 -> g1p
-    // Hold in g1p
-    step(0, 1, "S1.G1P_hold");
-
-    // Scenario 2: path through g1 -> tmp3 -> g1p with y=1, covering tmp3->g1p.
-    apply_reset();
-    step(0, 0, "S2.A_to_F1");
-    step(0, 0, "S2.F1_to_TMP0");
-    step(1, 0, "S2.TMP0_to_TMP1");
-    step(0, 0, "S2.TMP1_to_TMP2");
-    step(1, 0, "S2.TMP2_to_G1_y0");  // g1, y=0 -> next tmp3
-    step(0, 0, "S2.G1_to_TMP3");     // now in tmp3 (y=0)
-    step(0, 1, "S2.TMP3_to_G1P");    // tmp3, y=1 -> g1p
-    step(0, 1, "S2.G1P_hold2");
-
-    // Scenario 3: exercise resetn branches in g1p and g0p (if(~resetn)).
-    apply_reset();
-    // Drive into g1p
-    step(0, 0, "S3.A_to_F1");
-    step(0, 0, "S3.F1_to_TMP0");
-    step(1, 0, "S3.TMP0_to_TMP1");
-    step(0, 0, "S3.TMP1_to_TMP2");
-    step(1, 0, "S3.TMP2_to_G1");
-    step(0, 1, "S3.G1_to_G1P");
-    // Now assert resetn low while in g1p
-    dut->resetn = 0;
-    tick(dut.get(), ctx.get());
-    dut->resetn = 1;
-    state = A;
-
-    // Drive into g0p and reset there as well.
-    apply_reset();
-    step(0, 0, "S3b.A_to_F1");
-    step(0, 0, "S3b.F1_to_TMP0");
-    step(1, 0, "S3b.TMP0_to_TMP1");
-    step(0, 0, "S3b.TMP1_to_TMP2");
-    step(1, 0, "S3b.TMP2_to_G1");
-    step(0, 0, "S3b.G1_to_TMP3");
-    step(0, 0, "S3b.TMP3_to_G0P");
-    dut->resetn = 0;
-    tick(dut.get(), ctx.get());
-    dut->resetn = 1;
-    state = A;
+    auto apply_reset = [&]() {
+        clock(0, 0, 0, "reset");
+    };
+
+    auto step = [&](uint8_t x, uint8_t y, const char *ctx_str) {
+        clock(x, y, 1, ctx_str);
+    };
+
+    // Cover replay (the default run) and +fsm_explore (lib/fsm_explore.h). Input vector bits:
+    // 0 x, 1 y, 2 resetn. The full state is the state register and f/g;
+    // a second reset cycle clears f/g so that every reset ends in one state.
+    tb::FsmHooks hooks;
+    hooks.reset = [&]() {
+        apply_reset();
+        apply_reset();
+    };
+    hooks.step = [&](uint32_t in) {
+        clock(in & 1u, (in >> 1) & 1u, (in >> 2) & 1u, "fsm");
+    };
+    hooks.key = [&]() -> uint64_t {
+#ifdef TB_PUBLIC
+        return dut->rootp->top_module__DOT__state | (dut->f << 4) | (dut->g << 5);
+#else
+        return state | (f << 4) | (g << 5);
+#endif
+    };
+    hooks.state = [](uint64_t key) { return static_cast<unsigned>(key & 15u); };
+#ifdef TB_PUBLIC
+    hooks.restore = [&](uint64_t key) {
+        state = static_cast<int>(key & 15u);
+        f = (key >> 4) & 1u;
+        g = (key >> 5) & 1u;
+        dut->rootp->top_module__DOT__state = static_cast<uint8_t>(state);
+        dut->rootp->top_module__DOT__f = f;
+        dut->rootp->top_module__DOT__g = g;
+        dut->eval();
+        return true;
+    };
+#endif
+    const tb::FsmMode mode = tb::run_fsm_modes(ctx.get(), "dut_151", hooks, 3);
+    if (mode == tb::FsmMode::Failed) {
+        return EXIT_FAILURE;
+    }
+    if (mode == tb::FsmMode::Scripted) {
+        // Scenario 1: path to g1p via y=1, exercising g1 and g1p cases.
+        apply_reset();
+        // A -> f1 -> tmp0
+        step(0, 0, "S1.A_to_F1");        // A -> f1
+        step(0, 0, "S1.F1_to_TMP0");     // f1 -> tmp0
+        // tmp0 -> tmp1 -> tmp2
+        step(1, 0, "S1.TMP0_to_TMP1");   // tmp0 -> tmp1
+        step(0, 0, "S1.TMP1_to_TMP2");   // tmp1 -> tmp2
+        // tmp2 -> g1 (x=1), then g1 -> g1p (y=1)
+        step(1, 0, "S1.TMP2_to_G1");     // tmp2 -> g1
+        step(0, 1, "S1.G1_to_G1P");      // g1 -> g1p
+        // Hold in g1p
+        step(0, 1, "S1.G1P_hold");
+
+        // Scenario 2: path through g1 -> tmp3 -> g1p with y=1, covering tmp3->g1p.
+        apply_reset();
+        step(0, 0, "S2.A_to_F1");
+        step(0, 0, "S2.F1_to_TMP0");
+        step(1, 0, "S2.TMP0_to_TMP1");
+        step(0, 0, "S2.TMP1_to_TMP2");
+        step(1, 0, "S2.TMP2_to_G1_y0");  // g1, y=0 -> next tmp3
+        step(0, 0, "S2.G1_to_TMP3");     // now in tmp3 (y=0)
+        step(0, 1, "S2.TMP3_to_G1P");    // tmp3, y=1 -> g1p
+        step(0, 1, "S2.G1P_hold2");
+
+        // Scenario 3: exercise resetn branches in g1p and g0p (if(~resetn)).
+        apply_reset();
+        // Drive into g1p
+        step(0, 0, "S3.A_to_F1");
+        step(0, 0, "S3.F1_to_TMP0");
+        step(1, 0, "S3.TMP0_to_TMP1");
+        step(0, 0, "S3.TMP1_to_TMP2");
+        step(1, 0, "S3.TMP2_to_G1");
+        step(0, 1, "S3.G1_to_G1P");
+        // Now assert resetn low while in g1p
+        clock(0, 1, 0, "S3.G1P_reset");
+
+        // Drive into g0p and reset there as well.
+        apply_reset();
+        step(0, 0, "S3b.A_to_F1");
+        step(0, 0, "S3b.F1_to_TMP0");
+        step(1, 0, "S3b.TMP0_to_TMP1");
+        step(0, 0, "S3b.TMP1_to_TMP2");
+        step(1, 0, "S3b.TMP2_to_G1");
+        step(0, 0, "S3b.G1_to_TMP3");
+        step(0, 0, "S3b.TMP3_to_G0P");
+        clock(0, 0, 0, "S3b.G0P_reset");
+    }
 
     std::cout << "[TB] dut_151 passed: FSM with f/g outputs" << std::endl;
 
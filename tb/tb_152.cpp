@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_152.h"
+#include "lib/counter_soak.h"
 
 static inline void tick(Vdut_152 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -19,6 +20,7 @@ static inline void tick(Vdut_152 *dut, VerilatedContext *ctx) {
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_152>(ctx.get());
@@ -47,6 +49,23 @@ int main(int argc, char **argv) {
         tick(dut.get(), ctx.get());
     }
 
+    // +soak=<cycles>: long run against the closed-form reference (lib/counter_soak.h).
+    const tb::SoakConfig soak = tb::SoakConfig::from_plusargs(ctx.get());
+    if (soak.cycles != 0u) {
+        const bool ok = tb::run_counter_soak(
+            "dut_152", soak, 1u, 152u,
+            [&](uint64_t, bool event, uint32_t, bool) {
+                dut->reset = event;
+                tick(dut.get(), ctx.get());
+                return uint32_t(dut->q);
+            },
+            // q counts mod 1000 from the last reset
+            [](const tb::CounterEvent &e, uint64_t n) { return uint32_t((n - e.cycle) % 1000u); });
+        if (!ok) {
+            return EXIT_FAILURE;
+        }
+    }
+
     std::cout << "[TB] dut_152 passed: 0..999 counter with wrap-around" << std::endl;
 
 #if VM_COVERAGE
@@ -6,6 +6,10 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_157.h"
+#ifdef TB_PUBLIC
+#include "Vdut_157___024root.h"
+#endif
+#include "lib/fsm_explore.h"
 
 static inline void tick(Vdut_157 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -19,6 +23,7 @@ static inline void tick(Vdut_157 *dut, VerilatedContext *ctx) {
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_157>(ctx.get());
@@ -28,19 +33,17 @@ int main(int argc, char **argv) {
         SHIFT1=5, SHIFT2=6, SHIFT3=7, COUNT=8, DONE=9
     };
     uint8_t state = IDLE;
-
-    auto apply_reset = [&]() {
-        dut->reset = 1;
-        dut->data = 0;
-        dut->ack = 0;
-        tick(dut.get(), ctx.get());
-        dut->reset = 0;
-        state = IDLE;
-    };
-
-    auto step = [&](uint8_t data, uint8_t ack, const char *ctx_str) {
-        dut->data = data & 1u;
-        dut->ack = ack & 1u;
+    uint8_t count = 0;          // count output register
+    uint16_t count_1000 = 0;
+
+    // One clock of the RTL. The shift/count register block runs on every
+    // clock from the current state, also while reset is asserted.
+    auto clock = [&](uint8_t data, uint8_t ack, uint8_t reset, const char *ctx_str) {
+        data &= 1u;
+        ack &= 1u;
+        dut->data = data;
+        dut->ack = ack;
+        dut->reset = reset & 1u;
 
         uint8_t next = state;
         switch (state) {
@@ -52,64 +55,126 @@ int main(int argc, char **argv) {
             case SHIFT1:next = SHIFT2; break;
             case SHIFT2:next = SHIFT3; break;
             case SHIFT3:next = COUNT; break;
-            // In COUNT, remain in COUNT until the DUT asserts done, at which
-            // point we model a transition to DONE based on the observed output.
-            case COUNT: next = COUNT; break;
+            case COUNT: next = (count == 0 && count_1000 == 999) ? DONE : COUNT; break;
             case DONE:  next = ack ? IDLE : DONE; break;
         }
+        switch (state) {
+            case S1101: count = (count & 0x7u) | (data << 3); break;
+            case SHIFT1:count = (count & 0xbu) | (data << 2); break;
+            case SHIFT2:count = (count & 0xdu) | (data << 1); break;
+            case SHIFT3:count = (count & 0xeu) | data; break;
+            case COUNT:
+                if (count_1000 < 999) {
+                    ++count_1000;
+                } else {
+                    count = (count - 1u) & 0xfu;
+                    count_1000 = 0;
+                }
+                break;
+            default:    count_1000 = 0; break;
+        }
 
         tick(dut.get(), ctx.get());
-        if (state == COUNT && dut->done) {
-            state = DONE;
-        } else {
-            state = next;
-        }
+        state = (reset & 1u) ? uint8_t(IDLE) : next;
 
         uint8_t counting_exp = (state == COUNT) ? 1u : 0u;
         uint8_t done_exp = (state == DONE) ? 1u : 0u;
-        if (dut->counting != counting_exp || dut->done != done_exp) {
+        if (dut->counting != counting_exp || dut->done != done_exp || dut->count != count) {
             std::cerr << "[TB] dut_157 failed (" << ctx_str << "): "
                       << "state=" << int(state)
                       << " data=" << int(data)
                       << " ack=" << int(ack)
                       << " expected counting=" << int(counting_exp)
                       << " done=" << int(done_exp)
+                      << " count=" << int(count)
                       << " got counting=" << int(dut->counting)
-                      << " done=" << int(dut->done) << std::endl;
+                      << " done=" << int(dut->done)
+                      << " count=" << int(dut->count) << std::endl;
             std::exit(EXIT_FAILURE);
         }
     };
 
-    // Scenario 1: shift in a count value (e.g. 0b1010 = 10) then let it count down.
-    apply_reset();
-    // Feed 1101
-    step(1, 0, "S1_1");
-    step(1, 0, "S1_11");
-    step(0, 0, "S1_110");
-    step(1, 0, "S1_1101");
-    // SHIFT1..3: shift bits into count[3:0]
-    step(1, 0, "shift_bit3");  // SHIFT1
-    step(0, 0, "shift_bit2");  // SHIFT2
-    step(1, 0, "shift_bit1");  // SHIFT3 -> COUNT
-
-    // Let the counter run until done is asserted at least once.
-    bool saw_done = false;
-    for (int i = 0; i < 12000 && !saw_done; ++i) {
-        step(0, 0, "COUNT_run");
-        if (dut->done) saw_done = true;
-    }
-    if (!saw_done) {
-        std::cerr << "[TB] dut_157 failed: never saw done during COUNT" << std::endl;
+    auto apply_reset = [&]() {
+        clock(0, 0, 1, "reset");
+    };
+
+    auto step = [&](uint8_t data, uint8_t ack, const char *ctx_str) {
+        clock(data, ack, 0, ctx_str);
+    };
+
+    // Cover replay (the default run) and +fsm_explore (lib/fsm_explore.h). Input vector bits:
+    // 0 data, 1 ack. The full state keeps only the live parts of the
+    // counters: the bits shifted in so far, and count/count_1000 in COUNT.
+    // Explore with PUBLIC=1: otherwise each of the ~16k COUNT states is
+    // restored by replaying up to 16k cycles.
+    auto live_key = [](uint8_t st, uint8_t cnt, uint16_t cnt_1000) -> uint64_t {
+        switch (st) {
+            case SHIFT1: return st | ((cnt & 0x8u) << 4);
+            case SHIFT2: return st | ((cnt & 0xcu) << 4);
+            case SHIFT3: return st | ((cnt & 0xeu) << 4);
+            case COUNT:  return st | (cnt << 4) | (uint64_t(cnt_1000) << 8);
+            default:     return st;
+        }
+    };
+    tb::FsmHooks hooks;
+    hooks.reset = apply_reset;
+    hooks.step = [&](uint32_t in) { step(in & 1u, (in >> 1) & 1u, "fsm"); };
+    hooks.key = [&]() {
+#ifdef TB_PUBLIC
+        return live_key(dut->rootp->top_module__DOT__state, dut->count, dut->rootp->top_module__DOT__count_1000);
+#else
+        return live_key(state, count, count_1000);
+#endif
+    };
+    hooks.state = [](uint64_t key) { return static_cast<unsigned>(key & 15u); };
+#ifdef TB_PUBLIC
+    hooks.restore = [&](uint64_t key) {
+        state = static_cast<uint8_t>(key & 15u);
+        count = static_cast<uint8_t>((key >> 4) & 15u);
+        count_1000 = static_cast<uint16_t>(key >> 8);
+        dut->rootp->top_module__DOT__state = state;
+        dut->rootp->top_module__DOT__count_1000 = count_1000;
+        dut->rootp->top_module__DOT__count = count;
+        dut->eval();
+        return true;
+    };
+#endif
+    const tb::FsmMode mode = tb::run_fsm_modes(ctx.get(), "dut_157", hooks, 2);
+    if (mode == tb::FsmMode::Failed) {
         return EXIT_FAILURE;
     }
+    if (mode == tb::FsmMode::Scripted) {
+        // Scenario 1: shift in a count value (e.g. 0b1010 = 10) then let it count down.
+        apply_reset();
+        // Feed 1101
+        step(1, 0, "S1_1");
+        step(1, 0, "S1_11");
+        step(0, 0, "S1_110");
+        step(1, 0, "S1_1101");
+        // SHIFT1..3: shift bits into count[3:0]
+        step(1, 0, "shift_bit3");  // SHIFT1
+        step(0, 0, "shift_bit2");  // SHIFT2
+        step(1, 0, "shift_bit1");  // SHIFT3 -> COUNT
+
+        // Let the counter run until done is asserted at least once.
+        bool saw_done = false;
+        for (int i = 0; i < 12000 && !saw_done; ++i) {
+            step(0, 0, "COUNT_run");
+            if (dut->done) saw_done = true;
+        }
+        if (!saw_done) {
+            std::cerr << "[TB] dut_157 failed: never saw done during COUNT" << std::endl;
+            return EXIT_FAILURE;
+        }
 
-    // Acknowledge and go back to IDLE.
-    step(0, 1, "DONE_ack");
+        // Acknowledge and go back to IDLE.
+        step(0, 1, "DONE_ack");
 
-    // Scenario 2: random-ish pattern without completing the sequence.
-    apply_reset();
-    const uint8_t seq2[] = {0,1,0,1,1,0,0,1};
-    for (size_t i = 0; i < sizeof(seq2); ++i) step(seq2[i], 0, "random");
+        // Scenario 2: random-ish pattern without completing the sequence.
+        apply_reset();
+        const uint8_t seq2[] = {0,1,0,1,1,0,0,1};
+        for (size_t i = 0; i < sizeof(seq2); ++i) step(seq2[i], 0, "random");
+    }
 
     std::cout << "[TB] dut_157 passed: programmable countdown with 1000-cycle subcounter" << std::endl;
 
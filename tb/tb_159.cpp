@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_159.h"
+#include "lib/counter_soak.h"
 
 static inline void tick(Vdut_159 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -19,6 +20,7 @@ static inline void tick(Vdut_159 *dut, VerilatedContext *ctx) {
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_159>(ctx.get());
@@ -77,6 +79,25 @@ int main(int argc, char **argv) {
         run_down(cycles, "down_from_pattern");
     }
 
+    // +soak=<cycles>: long run against the closed-form reference (lib/counter_soak.h).
+    const tb::SoakConfig soak = tb::SoakConfig::from_plusargs(ctx.get());
+    if (soak.cycles != 0u) {
+        const bool ok = tb::run_counter_soak(
+            "dut_159", soak, 1024u, 159u,
+            [&](uint64_t, bool event, uint32_t value, bool) {
+                dut->load = event;
+                dut->data = static_cast<uint16_t>(value);
+                tick(dut.get(), ctx.get());
+                return uint32_t(dut->tc);
+            },
+            // the counter is at max(data - k, 0) k edges after a load, so tc
+            // (registered "reaches 0") is set from edge `data` on
+            [](const tb::CounterEvent &e, uint64_t n) { return uint32_t(n - e.cycle >= e.value); });
+        if (!ok) {
+            return EXIT_FAILURE;
+        }
+    }
+
     std::cout << "[TB] dut_159 passed: down-counter with terminal count tc" << std::endl;
 
 #if VM_COVERAGE
@@ -6,6 +6,7 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_160.h"
+#include "lib/reset_stress.h"
 
 static inline void tick(Vdut_160 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -16,9 +17,21 @@ static inline void tick(Vdut_160 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "state=WNT (01)";
+    static void reset(Vdut_160 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_160 *dut, uint64_t bits) {
+        dut->train_valid = bits & 1u;
+        dut->train_taken = (bits >> 1) & 1u;
+    }
+    static bool in_reset(const Vdut_160 *dut) { return dut->state == 1u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_160>(ctx.get());
@@ -76,6 +89,10 @@ int main(int argc, char **argv) {
         step(0, 0, "hold");
     }
 
+    if (!tb::run_reset_stress<Vdut_160, ResetTarget>(ctx.get(), "dut_160")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_160 passed: 2-bit saturating branch predictor FSM" << std::endl;
 
 #if VM_COVERAGE
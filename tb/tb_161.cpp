@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -6,6 +7,8 @@
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_161.h"
+#include "lib/reset_stress.h"
+#include "lib/tb_harness.h"
 
 static inline void tick(Vdut_161 *dut, VerilatedContext *ctx) {
     dut->clk = 0;
@@ -16,9 +19,144 @@ static inline void tick(Vdut_161 *dut, VerilatedContext *ctx) {
     ctx->timeInc(1);
 }
 
+static inline uint64_t xorshift64(uint64_t &s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+// In-flight branch: the history the DUT handed out with its prediction
+// (the checkpoint a real front end would keep for recovery), the predicted
+// and actual directions, and the cycle it resolves.
+struct InFlight {
+    uint32_t history;
+    uint64_t ready;
+    bool predicted;
+    bool taken;
+};
+
+// Fixed-capacity FIFO of in-flight branches; storage is allocated once with
+// the harness, nothing per branch.
+template <typename T, unsigned Capacity>
+class FixedRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+public:
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == Capacity; }
+    unsigned size() const { return count_; }
+    T &front() { return slots_[head_]; }
+    void push(const T &v) { slots_[(head_ + count_++) & (Capacity - 1)] = v; }
+    void pop() { head_ = (head_ + 1) & (Capacity - 1); --count_; }
+    void clear() { count_ = 0; }
+private:
+    T slots_[Capacity];
+    unsigned head_ = 0;
+    unsigned count_ = 0;
+};
+
+// Randomized speculative front end around the history register. Each cycle
+// may predict a branch (direction random) and push its checkpoint; the
+// oldest branch resolves in order +latency (default 8) to +latency+7 cycles
+// after it was predicted, and +mispredict_ppm (default 5%) of them turn out
+// wrong. A misprediction drives
+// train_mispredicted with the checkpoint and squashes every younger branch,
+// including one predicted in the same cycle (the DUT gives recovery
+// priority). Checked every cycle: the DUT history against the model, and at
+// each resolution the branch's checkpoint against the architectural
+// (correct-path) history, bit for bit. Idle train_* inputs carry noise.
+static bool run_speculative(Vdut_161 *dut, VerilatedContext *ctx, uint64_t cycles) {
+    const uint32_t mispredict_ppm = static_cast<uint32_t>(tb::plusarg_u64(ctx, "mispredict_ppm", 50000));
+    const uint64_t latency = std::max<uint64_t>(1, tb::plusarg_u64(ctx, "latency", 8));
+    FixedRing<InFlight, 64> ring;
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    uint32_t spec = 0;      // model of predict_history
+    uint32_t arch = 0;      // history of resolved (correct-path) branches
+    uint64_t predicted = 0, recoveries = 0, max_in_flight = 0;
+
+    dut->areset = 1;
+    tick(dut, ctx);
+    dut->areset = 0;
+
+    tb::Stopwatch sw;
+    for (uint64_t c = 0; c < cycles; ++c) {
+        const uint64_t r = xorshift64(rng);
+        bool recover = false;
+        bool recover_taken = false;
+        uint32_t recover_history = 0;
+        if (!ring.empty() && ring.front().ready <= c) {
+            const InFlight &b = ring.front();
+            if (b.history != arch) {
+                std::cerr << "[TB] dut_161 checkpoint mismatch at cycle " << c << ": expected=0x"
+                          << std::hex << arch << " got=0x" << b.history << std::dec << std::endl;
+                return false;
+            }
+            arch = (arch << 1) | (b.taken ? 1u : 0u);
+            if (b.predicted != b.taken) {
+                recover = true;
+                recover_taken = b.taken;
+                recover_history = b.history;
+                ring.clear();
+                ++recoveries;
+            } else {
+                ring.pop();
+            }
+        }
+
+        const bool predict_valid = !ring.full() && (r & 3u) != 0;
+        const bool predict_taken = (r >> 2) & 1u;
+        dut->predict_valid = predict_valid ? 1 : 0;
+        dut->predict_taken = predict_taken ? 1 : 0;
+        dut->train_mispredicted = recover ? 1 : 0;
+        dut->train_taken = recover ? (recover_taken ? 1 : 0) : ((r >> 3) & 1u);
+        dut->train_history = recover ? recover_history : static_cast<uint32_t>(r >> 32);
+
+        if (predict_valid && !recover) {
+            const bool wrong = (static_cast<uint32_t>(r >> 8) & 0xFFFFFu) % 1000000u < mispredict_ppm;
+            ring.push(InFlight{spec, c + latency + ((r >> 28) & 7u), predict_taken, predict_taken != wrong});
+            ++predicted;
+            max_in_flight = std::max<uint64_t>(max_in_flight, ring.size());
+        }
+
+        if (recover) {
+            spec = (recover_history << 1) | (recover_taken ? 1u : 0u);
+        } else if (predict_valid) {
+            spec = (spec << 1) | (predict_taken ? 1u : 0u);
+        }
+
+        tick(dut, ctx);
+        if (dut->predict_history != spec) {
+            std::cerr << "[TB] dut_161 speculative run failed at cycle " << c << (recover ? " (recovery)" : "")
+                      << ": expected=0x" << std::hex << spec << " got=0x" << dut->predict_history
+                      << std::dec << std::endl;
+            return false;
+        }
+    }
+    const double secs = sw.seconds();
+    tb::report_rate("dut_161", "speculative cycles", double(cycles), secs, "cyc");
+    std::cout << "[TB] dut_161 speculative run: " << predicted << " predictions, " << recoveries
+              << " recoveries checked, up to " << max_in_flight << " in flight" << std::endl;
+    return true;
+}
+
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget {
+    static constexpr const char *kResetState = "predict_history=0";
+    static void reset(Vdut_161 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_161 *dut, uint64_t bits) {
+        dut->predict_valid = bits & 1u;
+        dut->predict_taken = (bits >> 1) & 1u;
+        dut->train_mispredicted = (bits >> 2) & 1u;
+        dut->train_taken = (bits >> 3) & 1u;
+        dut->train_history = static_cast<uint32_t>(bits >> 32);
+    }
+    static bool in_reset(const Vdut_161 *dut) { return dut->predict_history == 0u; }
+};
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
     ctx->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_161>(ctx.get());
@@ -96,6 +234,16 @@ int main(int argc, char **argv) {
         step(false, false, false, 0, false, "idle_no_update");
     }
 
+    // Phase 4: randomized speculative pipeline, +cycles=<n> (default 200k;
+    // e.g. TB_ARGS="+cycles=100000000" for a long run).
+    if (!run_speculative(dut.get(), ctx.get(), tb::plusarg_u64(ctx.get(), "cycles", 200000))) {
+        return EXIT_FAILURE;
+    }
+
+    if (!tb::run_reset_stress<Vdut_161, ResetTarget>(ctx.get(), "dut_161")) {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_161 passed: global history register" << std::endl;
 
 #if VM_COVERAGE
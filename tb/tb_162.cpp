@@ -1,13 +1,19 @@
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "verilated.h"
 #include "verilated_cov.h"
 #include "Vdut_162.h"
+#include "lib/branch_trace.h"
+#include "lib/packed_pht.h"
+#include "lib/reset_stress.h"
+#include "lib/tb_harness.h"
 
 namespace
 {
@@ -33,6 +39,14 @@ namespace
         uint8_t ghr{};
     };
 
+    // Same model with the PHT packed 32 counters per word (tb::PackedPht);
+    // used as the golden model for trace replay.
+    struct PackedModelState
+    {
+        tb::PackedPht pht{7U, WNT};
+        uint8_t ghr{};
+    };
+
     uint8_t update_counter(uint8_t current, bool taken)
     {
         switch (current)
@@ -54,18 +68,317 @@ namespace
         state.ghr = 0U;
         state.pht.fill(WNT);
     }
+
+    void reset_model(PackedModelState &state)
+    {
+        state.ghr = 0U;
+        state.pht.fill(WNT);
+    }
+
+    bool pht_predict(const ModelState &state, uint8_t index) { return state.pht[index] >= WT; }
+    bool pht_predict(const PackedModelState &state, uint8_t index) { return state.pht.predict(index); }
+
+    void pht_train(ModelState &state, uint8_t index, bool taken)
+    {
+        state.pht[index] = update_counter(state.pht[index], taken);
+    }
+
+    void pht_train(PackedModelState &state, uint8_t index, bool taken) { state.pht.update(index, taken); }
+
+    bool models_agree(const ModelState &a, const PackedModelState &b)
+    {
+        for (uint8_t i = 0; i < 128U; ++i)
+        {
+            if (a.pht[i] != b.pht.get(i))
+            {
+                return false;
+            }
+        }
+        return a.ghr == b.ghr;
+    }
+
+    // Combinational outputs for `in` before the clock edge.
+    template <typename State>
+    bool model_predict(const State &state, const Inputs &in, uint8_t &history)
+    {
+        history = 0U;
+        if (!in.predict_valid)
+        {
+            return false;
+        }
+        const uint8_t predict_index = static_cast<uint8_t>((in.predict_pc ^ state.ghr) & 0x7FU);
+        history = state.ghr;
+        return pht_predict(state, predict_index);
+    }
+
+    // State after the clock edge; predicted_taken is model_predict's result.
+    template <typename State>
+    void model_clock(State &state, const Inputs &in, bool predicted_taken)
+    {
+        if (in.train_valid)
+        {
+            const uint8_t train_index =
+                static_cast<uint8_t>((in.train_pc ^ in.train_history) & 0x7FU);
+            pht_train(state, train_index, in.train_taken != 0U);
+        }
+
+        if (in.train_valid && in.train_mispredicted)
+        {
+            state.ghr = static_cast<uint8_t>(
+                ((in.train_history & 0x3FU) << 1U) | (in.train_taken ? 1U : 0U));
+        }
+        else if (in.predict_valid)
+        {
+            state.ghr = static_cast<uint8_t>(
+                ((state.ghr & 0x3FU) << 1U) | (predicted_taken ? 1U : 0U));
+        }
+    }
+
+    // Replays `trace` through tb::BranchPipeline: one branch predicted per
+    // cycle, trained `latency` cycles later with the history the DUT
+    // returned for it, wrong-path branches squashed after a misprediction.
+    // Both DUT outputs are checked against the model on every cycle.
+    Inputs to_inputs(const tb::BranchCycle &c)
+    {
+        Inputs in{};
+        in.predict_valid = c.predict_valid ? 1U : 0U;
+        in.predict_pc = static_cast<uint8_t>(c.predict_pc);
+        in.train_valid = c.train_valid ? 1U : 0U;
+        in.train_taken = c.train_taken ? 1U : 0U;
+        in.train_mispredicted = c.train_mispredicted ? 1U : 0U;
+        in.train_history = static_cast<uint8_t>(c.train_history);
+        in.train_pc = static_cast<uint8_t>(c.train_pc);
+        return in;
+    }
+
+    void drive(Vdut_162 *dut, const Inputs &in)
+    {
+        dut->predict_valid = in.predict_valid;
+        dut->predict_pc = in.predict_pc;
+        dut->train_valid = in.train_valid;
+        dut->train_taken = in.train_taken;
+        dut->train_mispredicted = in.train_mispredicted;
+        dut->train_history = in.train_history;
+        dut->train_pc = in.train_pc;
+    }
+
+    bool replay_trace(Vdut_162 *dut, VerilatedContext *context, PackedModelState &model,
+                      const tb::BranchTrace &trace, unsigned latency, tb::PredictorStats &stats)
+    {
+        tb::BranchPipeline pipe(trace, latency, 0x7FU);
+        tb::Stopwatch sw;
+        while (!pipe.done())
+        {
+            const Inputs in = to_inputs(pipe.begin());
+
+            uint8_t expected_history = 0U;
+            const bool expected_taken = model_predict(model, in, expected_history);
+
+            drive(dut, in);
+            dut->clk = 0U;
+            dut->eval();
+            context->timeInc(1);
+
+            if (dut->predict_taken != static_cast<uint8_t>(expected_taken) ||
+                dut->predict_history != expected_history)
+            {
+                std::cerr << "[TB] dut_162 replay mismatch at cycle " << pipe.cycle() << ": "
+                          << "expected taken=" << expected_taken
+                          << " history=" << static_cast<int>(expected_history)
+                          << ", got taken=" << static_cast<int>(dut->predict_taken)
+                          << " history=" << static_cast<int>(dut->predict_history)
+                          << std::endl;
+                return false;
+            }
+
+            dut->clk = 1U;
+            dut->eval();
+            context->timeInc(1);
+            model_clock(model, in, expected_taken);
+            pipe.end(expected_taken, expected_history);
+        }
+        stats = pipe.stats(sw.seconds());
+        return true;
+    }
+
+    // Model kernel alone for +bench: predict, then train immediately and
+    // shift the resolved outcome into the history, one trace branch at a
+    // time. Returns the misprediction count.
+    template <typename State>
+    uint64_t model_kernel(const tb::BranchTrace &trace, double &seconds)
+    {
+        State state{};
+        reset_model(state);
+        uint64_t mispredicts = 0U;
+        tb::Stopwatch sw;
+        for (size_t t = 0; t < trace.size(); ++t)
+        {
+            const uint8_t index = static_cast<uint8_t>(((trace[t].pc >> 2U) ^ state.ghr) & 0x7FU);
+            const bool taken = (trace[t].taken & 1U) != 0U;
+            mispredicts += pht_predict(state, index) != taken ? 1U : 0U;
+            pht_train(state, index, taken);
+            state.ghr = static_cast<uint8_t>(((state.ghr & 0x3FU) << 1U) | (taken ? 1U : 0U));
+        }
+        seconds = sw.seconds();
+        return mispredicts;
+    }
+
+    // Multi-seed regression (+seeds=<n>): n copies of the DUT replay their
+    // own synthetic traces (seeds 162, 163, ...) in lockstep. The golden
+    // PHTs of all copies share one tb::PackedPhtBank and are looked up and
+    // trained 64 instances per batch.
+    bool run_seed_regression(VerilatedContext *context, unsigned seeds, uint64_t branches, unsigned latency)
+    {
+        std::vector<std::unique_ptr<tb::BranchTrace>> traces;
+        std::vector<std::unique_ptr<Vdut_162>> duts;
+        std::vector<tb::BranchPipeline> pipes;
+        traces.reserve(seeds);
+        pipes.reserve(seeds);
+        for (unsigned k = 0; k < seeds; ++k)
+        {
+            traces.emplace_back(new tb::BranchTrace(tb::generate_branch_trace(branches, 162U + k)));
+            pipes.emplace_back(*traces.back(), latency, 0x7FU);
+            duts.emplace_back(new Vdut_162(context));
+            Vdut_162 *dut = duts.back().get();
+            drive(dut, Inputs{});
+            dut->clk = 0U;
+            dut->areset = 1U;
+            dut->eval();
+            dut->areset = 0U;
+            dut->eval();
+        }
+        tb::PackedPhtBank bank(seeds, 7U, WNT);
+        std::vector<uint8_t> ghr(seeds, 0U);
+        std::vector<Inputs> in(seeds);
+        uint32_t predict_index[64];
+        uint32_t train_index[64];
+
+        tb::Stopwatch sw;
+        bool running = true;
+        while (running)
+        {
+            running = false;
+            for (unsigned first = 0; first < seeds; first += 64U)
+            {
+                const unsigned n = std::min(64U, seeds - first);
+                uint64_t active = 0U;
+                uint64_t predict_valid = 0U;
+                uint64_t train_valid = 0U;
+                uint64_t train_taken = 0U;
+                for (unsigned j = 0; j < n; ++j)
+                {
+                    const unsigned k = first + j;
+                    predict_index[j] = 0U;
+                    train_index[j] = 0U;
+                    if (pipes[k].done())
+                    {
+                        continue;
+                    }
+                    active |= uint64_t(1) << j;
+                    in[k] = to_inputs(pipes[k].begin());
+                    predict_index[j] = (in[k].predict_pc ^ ghr[k]) & 0x7FU;
+                    train_index[j] = (in[k].train_pc ^ in[k].train_history) & 0x7FU;
+                    predict_valid |= uint64_t(in[k].predict_valid) << j;
+                    train_valid |= uint64_t(in[k].train_valid) << j;
+                    train_taken |= uint64_t(in[k].train_taken) << j;
+                    drive(duts[k].get(), in[k]);
+                    duts[k]->clk = 0U;
+                    duts[k]->eval();
+                }
+                if (active == 0U)
+                {
+                    continue;
+                }
+                running = true;
+                const uint64_t predicted = bank.predict_batch(first, n, predict_index) & predict_valid;
+                for (unsigned j = 0; j < n; ++j)
+                {
+                    const unsigned k = first + j;
+                    if (((active >> j) & 1U) == 0U)
+                    {
+                        continue;
+                    }
+                    const bool taken = ((predicted >> j) & 1U) != 0U;
+                    const uint8_t history = in[k].predict_valid ? ghr[k] : 0U;
+                    Vdut_162 *dut = duts[k].get();
+                    if (dut->predict_taken != static_cast<uint8_t>(taken) || dut->predict_history != history)
+                    {
+                        std::cerr << "[TB] dut_162 seed " << 162U + k << " mismatch at cycle " << pipes[k].cycle()
+                                  << ": expected taken=" << taken << " history=" << static_cast<int>(history)
+                                  << ", got taken=" << static_cast<int>(dut->predict_taken)
+                                  << " history=" << static_cast<int>(dut->predict_history) << std::endl;
+                        return false;
+                    }
+                    dut->clk = 1U;
+                    dut->eval();
+                    if (in[k].train_valid && in[k].train_mispredicted)
+                    {
+                        ghr[k] = static_cast<uint8_t>(((in[k].train_history & 0x3FU) << 1U) | in[k].train_taken);
+                    }
+                    else if (in[k].predict_valid)
+                    {
+                        ghr[k] = static_cast<uint8_t>(((ghr[k] & 0x3FU) << 1U) | (taken ? 1U : 0U));
+                    }
+                    pipes[k].end(taken, history);
+                }
+                bank.train_batch(first, n, train_index, train_valid & active, train_taken);
+            }
+            context->timeInc(2);
+        }
+        const double secs = sw.seconds();
+
+        uint64_t total = 0U;
+        uint64_t mispredicts = 0U;
+        double mpki_min = 1e9;
+        double mpki_max = 0.0;
+        for (auto &p : pipes)
+        {
+            const tb::PredictorStats &st = p.stats(secs);
+            total += st.branches;
+            mispredicts += st.mispredicts;
+            mpki_min = std::min(mpki_min, st.mpki());
+            mpki_max = std::max(mpki_max, st.mpki());
+        }
+        tb::report_rate("dut_162", "multi-seed replayed branches", double(total), secs, "br");
+        std::cout << "[TB] dut_162 " << seeds << " seeds: " << 1000.0 * double(mispredicts) / double(total)
+                  << " MPKI overall, " << mpki_min << " .. " << mpki_max << " per seed" << std::endl;
+        return true;
+    }
 }
 
+// Reset state and inputs for +reset_stress (lib/reset_stress.h).
+struct ResetTarget
+{
+    static constexpr const char *kResetState = "predict_taken=0 predict_history=0 (GHR=0, PHT all WNT)";
+    static void reset(Vdut_162 *dut, bool on) { dut->areset = on; }
+    static void inputs(Vdut_162 *dut, uint64_t bits)
+    {
+        dut->predict_valid = bits & 1u;
+        dut->predict_pc = (bits >> 1) & 0x7Fu;
+        dut->train_valid = (bits >> 8) & 1u;
+        dut->train_taken = (bits >> 9) & 1u;
+        dut->train_mispredicted = (bits >> 10) & 1u;
+        dut->train_history = (bits >> 11) & 0x7Fu;
+        dut->train_pc = (bits >> 18) & 0x7Fu;
+    }
+    static bool in_reset(const Vdut_162 *dut) { return dut->predict_taken == 0u && dut->predict_history == 0u; }
+};
+
 int main(int argc, char **argv)
 {
     Verilated::commandArgs(argc, argv);
     auto context = std::make_unique<VerilatedContext>();
+    context->commandArgs(argc, argv);
     context->traceEverOn(false);
 
     auto dut = std::make_unique<Vdut_162>(context.get());
 
     ModelState model{};
     reset_model(model);
+    // Runs alongside the array model through the scripted scenarios and
+    // must stay identical to it; the replay below then relies on it.
+    PackedModelState packed{};
+    reset_model(packed);
 
     auto apply_reset = [&]() {
         dut->clk = 0U;
@@ -83,20 +396,14 @@ int main(int argc, char **argv)
         dut->eval();
 
         reset_model(model);
+        reset_model(packed);
     };
 
     apply_reset();
 
     auto run_cycle = [&](const Inputs &in, const std::string &label) -> bool {
-        bool expected_taken = false;
         uint8_t expected_history = 0U;
-        if (in.predict_valid)
-        {
-            const uint8_t predict_index =
-                static_cast<uint8_t>((in.predict_pc ^ model.ghr) & 0x7FU);
-            expected_taken = model.pht[predict_index] >= WT;
-            expected_history = model.ghr;
-        }
+        const bool expected_taken = model_predict(model, in, expected_history);
 
         dut->predict_valid = in.predict_valid;
         dut->predict_pc = in.predict_pc;
@@ -123,24 +430,16 @@ int main(int argc, char **argv)
 
         dut->clk = 1U;
         dut->eval();
+        model_clock(model, in, expected_taken);
 
-        if (in.train_valid)
+        uint8_t packed_history = 0U;
+        const bool packed_taken = model_predict(packed, in, packed_history);
+        model_clock(packed, in, packed_taken);
+        if (packed_taken != expected_taken || packed_history != expected_history ||
+            !models_agree(model, packed))
         {
-            const uint8_t train_index =
-                static_cast<uint8_t>((in.train_pc ^ in.train_history) & 0x7FU);
-            model.pht[train_index] =
-                update_counter(model.pht[train_index], in.train_taken != 0U);
-        }
-
-        if (in.train_valid && in.train_mispredicted)
-        {
-            model.ghr = static_cast<uint8_t>(
-                ((in.train_history & 0x3FU) << 1U) | (in.train_taken ? 1U : 0U));
-        }
-        else if (in.predict_valid)
-        {
-            model.ghr = static_cast<uint8_t>(
-                ((model.ghr & 0x3FU) << 1U) | (expected_taken ? 1U : 0U));
+            std::cerr << "[TB] dut_162 packed PHT model diverged (" << label << ")" << std::endl;
+            return false;
         }
 
         dut->clk = 0U;
@@ -338,6 +637,51 @@ int main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
+    // Trace replay: +trace=<file> or a synthetic +branches=<n> trace
+    // (default 50k), trained +latency=<n> cycles after prediction (default 4),
+    // checked against the packed model. +bench also times both models on
+    // their own; +seeds=<n> runs the multi-seed regression.
+    {
+        const tb::BranchTrace trace(context.get(), 50000U, 162U);
+        const unsigned latency = static_cast<unsigned>(
+            std::max<uint64_t>(1U, tb::plusarg_u64(context.get(), "latency", 4U)));
+        tb::PredictorStats stats;
+        apply_reset();
+        if (!trace.ok() || !replay_trace(dut.get(), context.get(), packed, trace, latency, stats))
+        {
+            return EXIT_FAILURE;
+        }
+        tb::report_predictor("dut_162", stats);
+
+        if (tb::plusarg_flag(context.get(), "bench"))
+        {
+            double array_secs = 0.0;
+            double packed_secs = 0.0;
+            const uint64_t array_miss = model_kernel<ModelState>(trace, array_secs);
+            const uint64_t packed_miss = model_kernel<PackedModelState>(trace, packed_secs);
+            if (array_miss != packed_miss)
+            {
+                std::cerr << "[TB] dut_162 array and packed models disagree on the trace" << std::endl;
+                return EXIT_FAILURE;
+            }
+            tb::report_rate("dut_162", "array model kernel branches", double(trace.size()), array_secs, "br");
+            tb::report_rate("dut_162", "packed model kernel branches", double(trace.size()), packed_secs, "br");
+        }
+
+        const uint64_t seeds = tb::plusarg_u64(context.get(), "seeds", 0U);
+        if (seeds != 0U &&
+            !run_seed_regression(context.get(), static_cast<unsigned>(seeds),
+                                 tb::plusarg_u64(context.get(), "branches", 50000U), latency))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!tb::run_reset_stress<Vdut_162, ResetTarget>(context.get(), "dut_162"))
+    {
+        return EXIT_FAILURE;
+    }
+
     std::cout << "[TB] dut_162 passed all prediction and training scenarios"
               << std::endl;
 
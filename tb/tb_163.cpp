@@ -0,0 +1,176 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "verilated.h"
+#include "verilated_cov.h"
+#include "Vdut_163.h"
+#include "lib/gf2_jump.h"
+#include "lib/tb_harness.h"
+
+// Parameters follow the Verilog defaults unless overridden through the
+// Makefile, e.g. `make DUT=163 PARAMS="K=64" TB_ARGS=+bench`. Sweep K with
+//   for k in 1 8 32 64; do make DUT=163 PARAMS="K=$k" TB_ARGS=+bench; done
+#ifndef TB_PARAM_WIDTH
+#define TB_PARAM_WIDTH 32
+#endif
+#ifndef TB_PARAM_TAPS
+#define TB_PARAM_TAPS 0x80200003ull
+#endif
+#ifndef TB_PARAM_K
+#define TB_PARAM_K 8
+#endif
+
+static constexpr unsigned kWidth = TB_PARAM_WIDTH;
+static constexpr unsigned kLeap = TB_PARAM_K;
+static constexpr uint64_t kMask = kWidth >= 64 ? ~0ull : ((1ull << kWidth) - 1ull);
+static constexpr uint64_t kTaps = static_cast<uint64_t>(TB_PARAM_TAPS) & kMask;
+static constexpr uint64_t kBitsMask = kLeap >= 64 ? ~0ull : ((1ull << kLeap) - 1ull);
+
+static inline uint64_t step_lfsr(uint64_t q) {
+    return ((q >> 1) ^ ((q & 1ull) ? kTaps : 0ull)) & kMask;
+}
+
+// Bits shifted out over the next K steps, oldest in bit 0.
+static inline uint64_t leap_bits(uint64_t q) {
+    uint64_t bits = 0;
+    for (unsigned i = 0; i < kLeap; ++i) {
+        bits |= (q & 1ull) << i;
+        q = step_lfsr(q);
+    }
+    return bits;
+}
+
+static inline void tick(Vdut_163 *dut, VerilatedContext *ctx) {
+    dut->clk = 0;
+    dut->eval();
+    ctx->timeInc(1);
+    dut->clk = 1;
+    dut->eval();
+    ctx->timeInc(1);
+}
+
+static inline void load_seed(Vdut_163 *dut, VerilatedContext *ctx, uint64_t seed) {
+    dut->load = 1;
+    dut->seed = seed;
+    tick(dut, ctx);
+    dut->load = 0;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    ctx->traceEverOn(false);
+
+    auto dut = std::make_unique<Vdut_163>(ctx.get());
+
+    const tb::Gf2Jump jump(tb::Gf2Matrix::from_step(kWidth, step_lfsr));
+    const tb::Gf2Matrix leap = jump.power(kLeap);
+
+    dut->clk = 0;
+    dut->load = 0;
+    dut->seed = 0;
+    dut->reset = 1;
+    tick(dut.get(), ctx.get());
+    if (dut->q != 1u || dut->bits != 0u) {
+        std::cerr << "[TB] dut_163 failed after reset: q=0x" << std::hex
+                  << static_cast<uint64_t>(dut->q) << std::dec << std::endl;
+        return EXIT_FAILURE;
+    }
+    dut->reset = 0;
+
+    // Cycle-by-cycle check from reset and from random seeds, including
+    // all-ones, against the serial model and the K-step jump.
+    std::mt19937_64 rng(163);
+    uint64_t q_model = 1;
+    for (int run = 0; run < 8; ++run) {
+        if (run > 0) {
+            q_model = run == 1 ? kMask : (rng() & kMask);
+            if (q_model == 0) {
+                q_model = 1;
+            }
+            load_seed(dut.get(), ctx.get(), q_model);
+            if (dut->q != q_model || dut->bits != 0u) {
+                std::cerr << "[TB] dut_163 load failed: expected q=0x" << std::hex << q_model
+                          << " got 0x" << static_cast<uint64_t>(dut->q) << std::dec << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        for (int i = 0; i < 256; ++i) {
+            const uint64_t bits_model = leap_bits(q_model);
+            const uint64_t next_model = leap.apply(q_model);
+            tick(dut.get(), ctx.get());
+            if (dut->q != next_model || (dut->bits & kBitsMask) != bits_model) {
+                std::cerr << "[TB] dut_163 failed (seed run " << run << ", cycle " << i
+                          << "): expected q=0x" << std::hex << next_model << " bits=0x"
+                          << bits_model << " got q=0x" << static_cast<uint64_t>(dut->q)
+                          << " bits=0x" << static_cast<uint64_t>(dut->bits) << std::dec
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+            q_model = next_model;
+        }
+    }
+
+    // Reset takes priority over load.
+    dut->reset = 1;
+    dut->load = 1;
+    dut->seed = kMask;
+    tick(dut.get(), ctx.get());
+    dut->reset = 0;
+    dut->load = 0;
+    if (dut->q != 1u) {
+        std::cerr << "[TB] dut_163 failed: reset did not override load" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Stream splitting: every worker loads the seed at its offset in the
+    // sequence, runs its share and must land where the next one started.
+    const uint64_t cycles = tb::plusarg_u64(ctx.get(), "cycles", 1u << 14);
+    const bool bench = tb::plusarg_flag(ctx.get(), "bench");
+    const unsigned workers = bench ? tb::worker_count(ctx.get()) : 2u;
+    std::atomic<bool> ok{true};
+    tb::Stopwatch sw;
+    tb::run_workers(workers, [&](unsigned w) {
+        auto wctx = std::make_unique<VerilatedContext>();
+        wctx->traceEverOn(false);
+        auto wdut = std::make_unique<Vdut_163>(wctx.get());
+        wdut->clk = 0;
+        wdut->reset = 0;
+        const uint64_t start = jump.advance(1u, w * cycles * kLeap);
+        load_seed(wdut.get(), wctx.get(), start);
+        for (uint64_t c = 0; c < cycles; ++c) {
+            tick(wdut.get(), wctx.get());
+        }
+        if (wdut->q != jump.advance(1u, (w + 1) * cycles * kLeap)) {
+            std::cerr << "[TB] dut_163 worker " << w << " ended off-sequence" << std::endl;
+            ok = false;
+        }
+    });
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+    if (bench) {
+        const double secs = sw.seconds();
+        std::cout << "[TB] dut_163 WIDTH=" << kWidth << " K=" << kLeap << " on " << workers
+                  << " worker(s)" << std::endl;
+        tb::report_rate("dut_163", "generated bits", double(cycles) * kLeap * workers, secs,
+                        "bit");
+    }
+
+    std::cout << "[TB] dut_163 passed: loadable leap-forward LFSR (WIDTH=" << kWidth
+              << ", K=" << kLeap << ")" << std::endl;
+
+#if VM_COVERAGE
+    const char *covPath = std::getenv("VERILATOR_COV_FILE");
+    if (covPath == nullptr || covPath[0] == '\0') {
+        covPath = "coverage.dat";
+    }
+    VerilatedCov::write(covPath);
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,247 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "verilated_cov.h"
+#include "Vdut_167.h"
+#include "lib/tb_harness.h"
+
+// Built with `make DUT=167 REF=138` the serial dut_138 is linked in and fed
+// the same line bits one per clock; its outputs must match the word
+// version's per-bit masks, and both throughputs are reported.
+#ifdef TB_REF
+#include "Vdut_138.h"
+#endif
+
+#ifndef TB_PARAM_W
+#define TB_PARAM_W 8
+#endif
+
+static constexpr unsigned kW = TB_PARAM_W;
+static constexpr uint64_t kWMask = kW >= 64 ? ~0ull : ((1ull << kW) - 1ull);
+
+// Serial reference FSM, same encoding as dut_138.
+enum {
+    ST_NONE = 0,
+    ST_ONE  = 1,
+    ST_TWO  = 2,
+    ST_THREE= 3,
+    ST_FOUR = 4,
+    ST_FIVE = 5,
+    ST_SIX  = 6,
+    ST_DISC = 7,
+    ST_FLAG = 8,
+    ST_ERR  = 9
+};
+
+static inline uint8_t hdlc_next(uint8_t state, unsigned bit) {
+    switch (state) {
+        case ST_NONE:  return bit ? ST_ONE   : ST_NONE;
+        case ST_ONE:   return bit ? ST_TWO   : ST_NONE;
+        case ST_TWO:   return bit ? ST_THREE : ST_NONE;
+        case ST_THREE: return bit ? ST_FOUR  : ST_NONE;
+        case ST_FOUR:  return bit ? ST_FIVE  : ST_NONE;
+        case ST_FIVE:  return bit ? ST_SIX   : ST_DISC;
+        case ST_SIX:   return bit ? ST_ERR   : ST_FLAG;
+        case ST_DISC:  return bit ? ST_ONE   : ST_NONE;
+        case ST_FLAG:  return bit ? ST_ONE   : ST_NONE;
+        case ST_ERR:   return bit ? ST_ERR   : ST_NONE;
+        default:       return ST_NONE;
+    }
+}
+
+// Line bits in transmission order, packed 64 per word.
+struct LineBits {
+    std::vector<uint64_t> words;
+    uint64_t count = 0;
+
+    void push(unsigned bit) {
+        if ((count & 63u) == 0) words.push_back(0);
+        words.back() |= static_cast<uint64_t>(bit & 1u) << (count & 63u);
+        ++count;
+    }
+    // kW bits starting at pos (zero past the end).
+    uint64_t take(uint64_t pos) const {
+        const uint64_t w = pos >> 6, s = pos & 63u;
+        uint64_t v = w < words.size() ? words[w] >> s : 0;
+        if (s != 0 && w + 1 < words.size()) v |= words[w + 1] << (64 - s);
+        return v & kWMask;
+    }
+};
+
+struct HdlcStream {
+    LineBits line;
+    uint64_t flags = 0;
+    uint64_t stuffed = 0;
+    uint64_t aborts = 0;
+};
+
+static void push_flag(HdlcStream &s) {
+    static const unsigned kFlag[8] = {0, 1, 1, 1, 1, 1, 1, 0};
+    for (unsigned b : kFlag) s.line.push(b);
+    ++s.flags;
+}
+
+// Random frames with payload bit stuffing, back-to-back flags and aborts
+// (seven or more ones). Every stuffed zero must produce exactly one disc and
+// every flag exactly one flag pulse.
+static HdlcStream make_stream(std::mt19937_64 &rng, uint64_t payload_bytes) {
+    HdlcStream s;
+    uint64_t produced = 0;
+    push_flag(s);
+    while (produced < payload_bytes) {
+        const unsigned len = 1 + static_cast<unsigned>(rng() % 64);
+        unsigned ones = 0;
+        for (unsigned i = 0; i < len; ++i) {
+            // Bias towards 0xFF runs so stuffing is frequent.
+            const uint8_t byte = (rng() & 3u) == 0 ? 0xFFu : static_cast<uint8_t>(rng());
+            for (unsigned b = 0; b < 8; ++b) {
+                const unsigned bit = (byte >> b) & 1u;
+                s.line.push(bit);
+                ones = bit ? ones + 1 : 0;
+                if (ones == 5) {
+                    s.line.push(0);
+                    ++s.stuffed;
+                    ones = 0;
+                }
+            }
+        }
+        produced += len;
+        if ((rng() & 31u) == 0) {
+            const unsigned n = 7 + static_cast<unsigned>(rng() % 4);
+            for (unsigned i = 0; i < n; ++i) s.line.push(1);
+            ++s.aborts;
+        }
+        push_flag(s);
+        if ((rng() & 7u) == 0) push_flag(s);
+    }
+    return s;
+}
+
+template <typename Model>
+static inline void tick(Model *dut, VerilatedContext *ctx) {
+    dut->clk = 0;
+    dut->eval();
+    ctx->timeInc(1);
+    dut->clk = 1;
+    dut->eval();
+    ctx->timeInc(1);
+}
+
+template <typename Model>
+static inline void apply_reset(Model *dut, VerilatedContext *ctx) {
+    dut->reset = 1;
+    dut->in = 0;
+    tick(dut, ctx);
+    dut->reset = 0;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    ctx->traceEverOn(false);
+
+    auto dut = std::make_unique<Vdut_167>(ctx.get());
+#ifdef TB_REF
+    auto serial = std::make_unique<Vdut_138>(ctx.get());
+#endif
+
+    // +bytes=<n> payload bytes (default 64 KiB; use megabytes for throughput)
+    std::mt19937_64 rng(167);
+    const HdlcStream s = make_stream(rng, tb::plusarg_u64(ctx.get(), "bytes", 64u * 1024u));
+    const uint64_t cycles = (s.line.count + kW - 1) / kW;
+
+    dut->clk = 0;
+    apply_reset(dut.get(), ctx.get());
+    if (dut->disc != 0u || dut->flag != 0u || dut->err != 0u) {
+        std::cerr << "[TB] dut_167 failed: outputs not clear after reset" << std::endl;
+        return EXIT_FAILURE;
+    }
+#ifdef TB_REF
+    serial->clk = 0;
+    apply_reset(serial.get(), ctx.get());
+#endif
+
+    uint8_t state = ST_NONE;
+    uint64_t discs = 0, flags = 0;
+    for (uint64_t c = 0; c < cycles; ++c) {
+        const uint64_t word = s.line.take(c * kW);
+        uint64_t disc_exp = 0, flag_exp = 0, err_exp = 0;
+        for (unsigned i = 0; i < kW; ++i) {
+            const unsigned bit = (word >> i) & 1u;
+            state = hdlc_next(state, bit);
+            disc_exp |= static_cast<uint64_t>(state == ST_DISC) << i;
+            flag_exp |= static_cast<uint64_t>(state == ST_FLAG) << i;
+            err_exp  |= static_cast<uint64_t>(state == ST_ERR) << i;
+#ifdef TB_REF
+            serial->in = bit;
+            tick(serial.get(), ctx.get());
+            if (serial->disc != ((disc_exp >> i) & 1u) || serial->flag != ((flag_exp >> i) & 1u) ||
+                serial->err != ((err_exp >> i) & 1u)) {
+                std::cerr << "[TB] dut_167 serial reference mismatch at line bit "
+                          << c * kW + i << std::endl;
+                return EXIT_FAILURE;
+            }
+#endif
+        }
+        dut->in = word;
+        tick(dut.get(), ctx.get());
+        if (dut->disc != disc_exp || dut->flag != flag_exp || dut->err != err_exp) {
+            std::cerr << "[TB] dut_167 failed at word " << c << " (W=" << kW << "): expected disc=0x"
+                      << std::hex << disc_exp << " flag=0x" << flag_exp << " err=0x" << err_exp
+                      << " got disc=0x" << static_cast<uint64_t>(dut->disc) << " flag=0x"
+                      << static_cast<uint64_t>(dut->flag) << " err=0x"
+                      << static_cast<uint64_t>(dut->err) << std::dec << std::endl;
+            return EXIT_FAILURE;
+        }
+        discs += static_cast<uint64_t>(__builtin_popcountll(disc_exp));
+        flags += static_cast<uint64_t>(__builtin_popcountll(flag_exp));
+    }
+    if (discs != s.stuffed || flags != s.flags) {
+        std::cerr << "[TB] dut_167 failed: " << discs << " discards for " << s.stuffed
+                  << " stuffed zeros, " << flags << " flags for " << s.flags << " sent"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Throughput on the same stream, no checking.
+    {
+        apply_reset(dut.get(), ctx.get());
+        tb::Stopwatch sw;
+        for (uint64_t c = 0; c < cycles; ++c) {
+            dut->in = s.line.take(c * kW);
+            tick(dut.get(), ctx.get());
+        }
+        tb::report_rate("dut_167", "word-parallel line bits", double(cycles) * kW, sw.seconds(),
+                        "bit");
+    }
+#ifdef TB_REF
+    {
+        apply_reset(serial.get(), ctx.get());
+        tb::Stopwatch sw;
+        for (uint64_t p = 0; p < s.line.count; ++p) {
+            serial->in = (s.line.words[p >> 6] >> (p & 63u)) & 1u;
+            tick(serial.get(), ctx.get());
+        }
+        tb::report_rate("dut_167", "serial line bits", double(s.line.count), sw.seconds(), "bit");
+    }
+#endif
+
+    std::cout << "[TB] dut_167 passed: W=" << kW << " HDLC decoder, " << s.line.count
+              << " line bits, " << s.flags << " flags, " << s.stuffed << " stuffed zeros, "
+              << s.aborts << " aborts" << std::endl;
+
+#if VM_COVERAGE
+    const char *covPath = std::getenv("VERILATOR_COV_FILE");
+    if (covPath == nullptr || covPath[0] == '\0') {
+        covPath = "coverage.dat";
+    }
+    VerilatedCov::write(covPath);
+#endif
+    return EXIT_SUCCESS;
+}
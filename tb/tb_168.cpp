@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "verilated_cov.h"
+#include "Vdut_168.h"
+#include "lib/tb_harness.h"
+#include "lib/wide_port.h"
+
+// Lane count follows the Verilog default unless overridden, e.g.
+//   for n in 1 4 16 64 256; do make DUT=168 PARAMS="N=$n"; done
+// to see aggregate bytes/sec and eval cost as the bank grows.
+#ifndef TB_PARAM_N
+#define TB_PARAM_N 8
+#endif
+
+static constexpr unsigned kLanes = TB_PARAM_N;
+static constexpr unsigned kWords = (kLanes + 31) / 32;
+
+static inline void tick(Vdut_168 *dut, VerilatedContext *ctx) {
+    dut->clk = 0;
+    dut->eval();
+    ctx->timeInc(1);
+    dut->clk = 1;
+    dut->eval();
+    ctx->timeInc(1);
+}
+
+// Per-lane frame generator: idle gap, start, 8 data bits LSB first, odd
+// parity, stop. About 2% of frames carry a bad stop bit or bad parity; the
+// receiver must drop those and resync (one idle bit after a bad stop).
+struct LaneEncoder {
+    uint32_t bits = 0;
+    unsigned left = 0;
+    bool after_error = false;
+};
+
+struct LaneStimulus {
+    std::vector<uint32_t> in;        // cycles x kWords, packed lane bits
+    std::vector<uint32_t> done;      // cycles x kWords, expected done
+    std::vector<std::vector<uint8_t>> bytes;  // expected bytes per lane
+    uint64_t good_bytes = 0;
+};
+
+static LaneStimulus make_stimulus(uint64_t cycles, uint64_t seed) {
+    LaneStimulus s;
+    s.in.assign(cycles * kWords, 0);
+    s.done.assign(cycles * kWords, 0);
+    s.bytes.resize(kLanes);
+    std::mt19937_64 rng(seed);
+    std::vector<LaneEncoder> enc(kLanes);
+    for (uint64_t c = 0; c < cycles; ++c) {
+        for (unsigned l = 0; l < kLanes; ++l) {
+            LaneEncoder &e = enc[l];
+            if (e.left == 0) {
+                const uint64_t r = rng();
+                const uint8_t byte = static_cast<uint8_t>(r);
+                unsigned idle = static_cast<unsigned>((r >> 8) % 3);
+                if (e.after_error && idle == 0) idle = 1;
+                const bool bad_stop = ((r >> 16) & 0x7F) == 0;
+                const bool bad_parity = !bad_stop && ((r >> 23) & 0x7F) == 0;
+                const unsigned odd = (__builtin_popcount(byte) & 1u) ^ 1u ^ (bad_parity ? 1u : 0u);
+                // idle ones, start 0, data, parity, stop
+                e.bits = ((1u << idle) - 1u) | (uint32_t(byte) << (idle + 1)) |
+                         (odd << (idle + 9)) | ((bad_stop ? 0u : 1u) << (idle + 10));
+                e.left = idle + 11;
+                e.after_error = bad_stop;
+                const uint64_t stop_cycle = c + e.left - 1;
+                if (!bad_stop && !bad_parity && stop_cycle < cycles) {
+                    s.done[stop_cycle * kWords + l / 32] |= 1u << (l % 32);
+                    s.bytes[l].push_back(byte);
+                    ++s.good_bytes;
+                }
+            }
+            s.in[c * kWords + l / 32] |= (e.bits & 1u) << (l % 32);
+            e.bits >>= 1;
+            --e.left;
+        }
+    }
+    return s;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    ctx->traceEverOn(false);
+
+    auto dut = std::make_unique<Vdut_168>(ctx.get());
+
+    const uint64_t cycles = tb::plusarg_u64(ctx.get(), "cycles", 20000);
+    const LaneStimulus s = make_stimulus(cycles, 168);
+    uint32_t idle_ones[kWords];
+    for (unsigned w = 0; w < kWords; ++w) {
+        idle_ones[w] = (kLanes - 32 * w >= 32) ? 0xFFFFFFFFu : ((1u << (kLanes - 32 * w)) - 1u);
+    }
+
+    auto apply_reset = [&]() {
+        dut->clk = 0;
+        dut->reset = 1;
+        tb::put_words(dut->in, idle_ones);
+        tick(dut.get(), ctx.get());
+        dut->reset = 0;
+    };
+
+    apply_reset();
+    for (unsigned w = 0; w < kWords; ++w) {
+        if (tb::get_word(dut->done, w) != 0u) {
+            std::cerr << "[TB] dut_168 failed: done set after reset" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<size_t> next(kLanes, 0);
+    for (uint64_t c = 0; c < cycles; ++c) {
+        tb::put_words(dut->in, &s.in[c * kWords]);
+        tick(dut.get(), ctx.get());
+        for (unsigned w = 0; w < kWords; ++w) {
+            const uint32_t got = tb::get_word(dut->done, w);
+            const uint32_t exp = s.done[c * kWords + w];
+            if (got != exp) {
+                std::cerr << "[TB] dut_168 done mismatch at cycle " << c << " lanes " << 32 * w
+                          << "..: expected 0x" << std::hex << exp << " got 0x" << got << std::dec
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+            for (uint32_t m = got; m != 0; m &= m - 1) {
+                const unsigned l = 32 * w + static_cast<unsigned>(__builtin_ctz(m));
+                const uint8_t byte = tb::get_byte(dut->out_byte, l);
+                if (byte != s.bytes[l][next[l]]) {
+                    std::cerr << "[TB] dut_168 lane " << l << " byte " << next[l] << ": expected 0x"
+                              << std::hex << int(s.bytes[l][next[l]]) << " got 0x" << int(byte)
+                              << std::dec << std::endl;
+                    return EXIT_FAILURE;
+                }
+                ++next[l];
+            }
+        }
+    }
+
+    // Throughput: replay the packed buffer without checking.
+    apply_reset();
+    tb::Stopwatch sw;
+    for (uint64_t c = 0; c < cycles; ++c) {
+        tb::put_words(dut->in, &s.in[c * kWords]);
+        tick(dut.get(), ctx.get());
+    }
+    const double secs = sw.seconds();
+    std::cout << "[TB] dut_168 N=" << kLanes << ": " << 1e9 * secs / double(2 * cycles)
+              << " ns/eval" << std::endl;
+    tb::report_rate("dut_168", "aggregate received bytes", double(s.good_bytes), secs, "B");
+
+    std::cout << "[TB] dut_168 passed: " << kLanes << "-lane serial receiver bank, "
+              << s.good_bytes << " bytes over " << cycles << " cycles" << std::endl;
+
+#if VM_COVERAGE
+    const char *covPath = std::getenv("VERILATOR_COV_FILE");
+    if (covPath == nullptr || covPath[0] == '\0') {
+        covPath = "coverage.dat";
+    }
+    VerilatedCov::write(covPath);
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "verilated_cov.h"
+#include "Vdut_170.h"
+#include "lib/tb_harness.h"
+#include "lib/wide_port.h"
+
+// Built with `make DUT=170 REF=154` the one-bit-per-clock dut_154 is linked
+// in and fed the same stream serially. Word width follows the Verilog
+// default unless overridden, e.g.
+//   for w in 1 8 32 64; do make DUT=170 REF=154 PARAMS="W=$w"; done
+// for the bits/sec comparison.
+#ifdef TB_REF
+#include "Vdut_154.h"
+#endif
+
+#ifndef TB_PARAM_W
+#define TB_PARAM_W 8
+#endif
+
+static constexpr unsigned kBits = TB_PARAM_W;
+static constexpr unsigned kWords = (kBits + 31) / 32;
+
+template <typename Model>
+static inline void tick(Model *dut, VerilatedContext *ctx) {
+    dut->clk = 0;
+    dut->eval();
+    ctx->timeInc(1);
+    dut->clk = 1;
+    dut->eval();
+    ctx->timeInc(1);
+}
+
+// Serial model of dut_154.
+struct Detector {
+    enum { IDLE = 0, S1 = 1, S11 = 2, S110 = 3, S1101 = 4 };
+    uint8_t state = IDLE;
+
+    void step(unsigned data) {
+        switch (state) {
+            case IDLE:  state = data ? S1    : IDLE; break;
+            case S1:    state = data ? S11   : IDLE; break;
+            case S11:   state = data ? S11   : S110; break;
+            case S110:  state = data ? S1101 : IDLE; break;
+            default:    break;
+        }
+    }
+    bool found() const { return state == S1101; }
+};
+
+// The stream is cut into segments of 1..2048 bits (rounded up to whole
+// words), each starting with a reset. A segment's density of ones is 1/2,
+// 1/16 or 15/16, so first matches land anywhere from the first word to
+// never, and many of them straddle word boundaries.
+struct Stream {
+    std::vector<uint32_t> in;       // words x kWords
+    std::vector<uint8_t> reset;     // reset before word i
+};
+
+static Stream make_stream(uint64_t bits, uint64_t seed) {
+    Stream s;
+    const uint64_t words = (bits + kBits - 1) / kBits;
+    s.in.assign(words * kWords, 0);
+    s.reset.assign(words, 0);
+    std::mt19937_64 rng(seed);
+    uint64_t left = 0;
+    unsigned density = 8;
+    for (uint64_t w = 0; w < words; ++w) {
+        if (left == 0) {
+            s.reset[w] = 1;
+            left = (1 + rng() % 2048 + kBits - 1) / kBits;
+            static const unsigned kDensity[] = {8, 1, 15};
+            density = kDensity[rng() % 3];
+        }
+        --left;
+        for (unsigned b = 0; b < kBits; ++b) {
+            if ((rng() & 15u) < density) s.in[w * kWords + b / 32] |= 1u << (b % 32);
+        }
+    }
+    return s;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    ctx->traceEverOn(false);
+
+    auto dut = std::make_unique<Vdut_170>(ctx.get());
+#ifdef TB_REF
+    auto serial = std::make_unique<Vdut_154>(ctx.get());
+    serial->clk = 0;
+    serial->data = 0;
+#endif
+
+    // +bits=<n> stream length (default 2M bits).
+    const uint64_t bits = tb::plusarg_u64(ctx.get(), "bits", uint64_t(1) << 21);
+    const Stream s = make_stream(bits, 170);
+    const uint64_t words = s.reset.size();
+    const uint32_t zero[kWords] = {};
+
+    dut->clk = 0;
+    tb::put_words(dut->data, zero);
+
+    Detector model;
+    uint64_t segments = 0;
+    uint64_t matches = 0;
+    uint64_t straddling = 0;
+    for (uint64_t w = 0; w < words; ++w) {
+        if (s.reset[w]) {
+            dut->reset = 1;
+            tick(dut.get(), ctx.get());
+            dut->reset = 0;
+#ifdef TB_REF
+            serial->reset = 1;
+            tick(serial.get(), ctx.get());
+            serial->reset = 0;
+#endif
+            model = Detector();
+            ++segments;
+        }
+        const uint32_t *word = &s.in[w * kWords];
+        const bool was_found = model.found();
+        int first = -1;
+        for (unsigned b = 0; b < kBits; ++b) {
+            const unsigned bit = (word[b / 32] >> (b % 32)) & 1u;
+            model.step(bit);
+            if (first < 0 && !was_found && model.found()) first = int(b);
+#ifdef TB_REF
+            serial->data = bit;
+            tick(serial.get(), ctx.get());
+            if (bool(serial->start_shifting) != model.found()) {
+                std::cerr << "[TB] dut_154 reference mismatch at word " << w << " bit " << b
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+#endif
+        }
+
+        tb::put_words(dut->data, word);
+        tick(dut.get(), ctx.get());
+
+        const bool exp_match = first >= 0;
+        if (bool(dut->start_shifting) != model.found() || bool(dut->match) != exp_match ||
+            (exp_match && unsigned(dut->pos) != unsigned(first))) {
+            std::cerr << "[TB] dut_170 failed at word " << w << ": expected start="
+                      << model.found() << " match=" << exp_match << " pos=" << first
+                      << " got start=" << int(dut->start_shifting) << " match=" << int(dut->match)
+                      << " pos=" << int(dut->pos) << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (exp_match) {
+            ++matches;
+            if (first < 3) ++straddling;
+        }
+    }
+
+    // Throughput on the same stream, no checking.
+    {
+        tb::Stopwatch sw;
+        for (uint64_t w = 0; w < words; ++w) {
+            if (s.reset[w]) {
+                dut->reset = 1;
+                tick(dut.get(), ctx.get());
+                dut->reset = 0;
+            }
+            tb::put_words(dut->data, &s.in[w * kWords]);
+            tick(dut.get(), ctx.get());
+        }
+        tb::report_rate("dut_170", "word detector bits", double(words * kBits), sw.seconds(), "bit");
+    }
+#ifdef TB_REF
+    {
+        tb::Stopwatch sw;
+        for (uint64_t w = 0; w < words; ++w) {
+            if (s.reset[w]) {
+                serial->reset = 1;
+                tick(serial.get(), ctx.get());
+                serial->reset = 0;
+            }
+            for (unsigned b = 0; b < kBits; ++b) {
+                serial->data = (s.in[w * kWords + b / 32] >> (b % 32)) & 1u;
+                tick(serial.get(), ctx.get());
+            }
+        }
+        tb::report_rate("dut_170", "serial detector bits", double(words * kBits), sw.seconds(), "bit");
+    }
+#endif
+
+    std::cout << "[TB] dut_170 passed: W=" << kBits << " 1101 detector, " << matches
+              << " first matches (" << straddling << " across words) in " << segments
+              << " segments, " << words * kBits << " bits" << std::endl;
+
+#if VM_COVERAGE
+    const char *covPath = std::getenv("VERILATOR_COV_FILE");
+    if (covPath == nullptr || covPath[0] == '\0') {
+        covPath = "coverage.dat";
+    }
+    VerilatedCov::write(covPath);
+#endif
+    return EXIT_SUCCESS;
+}
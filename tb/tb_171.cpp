@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+#include "verilated_cov.h"
+#include "Vdut_171.h"
+#include "lib/branch_trace.h"
+#include "lib/tb_harness.h"
+
+// Built with `make DUT=171 REF=162` (default parameters) the fixed dut_162
+// runs in lockstep with dut_171 and every output must agree.
+//
+// Design-space sweep: SWEEP builds dut_171 once per configuration and links
+// all of them in, e.g.
+//   make DUT=171 TB_ARGS="+branches=10000000 +threads=5" SWEEP="HIST_BITS=6:PHT_BITS=6
+//       HIST_BITS=8:PHT_BITS=8 HIST_BITS=10:PHT_BITS=10 HIST_BITS=12:PHT_BITS=12 HIST_BITS=8:PHT_BITS=12"
+// Each configuration replays the same trace in its own worker thread and
+// the run ends with an MPKI / throughput table.
+#ifdef TB_REF
+#include "Vdut_162.h"
+#endif
+#ifdef TB_SWEEP
+#include "tb_sweep.h"
+#include "lib/sweep.h"
+#endif
+
+#ifndef TB_PARAM_HIST_BITS
+#define TB_PARAM_HIST_BITS 7
+#endif
+#ifndef TB_PARAM_PHT_BITS
+#define TB_PARAM_PHT_BITS 7
+#endif
+
+namespace
+{
+    constexpr uint8_t WNT = 1U;
+    constexpr uint8_t WT = 2U;
+
+    // Reference gshare of any geometry, same update rules as dut_162.
+    struct GshareModel
+    {
+        unsigned hist_bits;
+        unsigned pht_bits;
+        std::vector<uint8_t> pht;
+        uint32_t ghr = 0U;
+
+        GshareModel(unsigned h, unsigned p) : hist_bits(h), pht_bits(p), pht(size_t(1) << p, WNT) {}
+
+        uint32_t hist_mask() const { return (1U << hist_bits) - 1U; }
+        uint32_t pc_mask() const { return (1U << pht_bits) - 1U; }
+
+        void reset()
+        {
+            std::fill(pht.begin(), pht.end(), WNT);
+            ghr = 0U;
+        }
+
+        bool predict(uint32_t pc) const { return pht[(pc ^ ghr) & pc_mask()] >= WT; }
+
+        void train(uint32_t pc, uint32_t history, bool taken)
+        {
+            uint8_t &c = pht[(pc ^ history) & pc_mask()];
+            c = taken ? static_cast<uint8_t>(c + (c != 3U)) : static_cast<uint8_t>(c - (c != 0U));
+        }
+
+        void update_history(bool train_mispredicted, uint32_t train_history, bool train_taken,
+                            bool predict_valid, bool predict_taken)
+        {
+            if (train_mispredicted)
+            {
+                ghr = ((train_history << 1U) | (train_taken ? 1U : 0U)) & hist_mask();
+            }
+            else if (predict_valid)
+            {
+                ghr = ((ghr << 1U) | (predict_taken ? 1U : 0U)) & hist_mask();
+            }
+        }
+    };
+
+    template <typename Model>
+    void apply_reset(Model *dut)
+    {
+        dut->clk = 0U;
+        dut->predict_valid = 0U;
+        dut->predict_pc = 0U;
+        dut->train_valid = 0U;
+        dut->train_taken = 0U;
+        dut->train_mispredicted = 0U;
+        dut->train_history = 0U;
+        dut->train_pc = 0U;
+        dut->areset = 1U;
+        dut->eval();
+        dut->areset = 0U;
+        dut->eval();
+    }
+
+    // Same tb::BranchPipeline replay as tb_162, checked against the model
+    // every cycle. `on_cycle` sees the DUT after the combinational
+    // evaluation (for lockstep references) and may veto.
+    template <typename Model, typename OnCycle>
+    bool replay_trace(Model *dut, VerilatedContext *ctx, const char *name, GshareModel &model,
+                      const tb::BranchTrace &trace, unsigned latency, tb::PredictorStats &stats,
+                      OnCycle on_cycle)
+    {
+        tb::BranchPipeline pipe(trace, latency, model.pc_mask());
+        apply_reset(dut);
+        model.reset();
+        tb::Stopwatch sw;
+        while (!pipe.done())
+        {
+            const tb::BranchCycle &c = pipe.begin();
+            dut->predict_valid = c.predict_valid ? 1U : 0U;
+            dut->predict_pc = c.predict_pc;
+            dut->train_valid = c.train_valid ? 1U : 0U;
+            dut->train_taken = c.train_taken ? 1U : 0U;
+            dut->train_mispredicted = c.train_mispredicted ? 1U : 0U;
+            dut->train_history = c.train_history;
+            dut->train_pc = c.train_pc;
+            dut->clk = 0U;
+            dut->eval();
+            ctx->timeInc(1);
+
+            const bool expected_taken = c.predict_valid && model.predict(c.predict_pc);
+            const uint32_t expected_history = c.predict_valid ? model.ghr : 0U;
+            if (dut->predict_taken != static_cast<uint8_t>(expected_taken) ||
+                dut->predict_history != expected_history)
+            {
+                std::cerr << "[TB] " << name << " replay mismatch at cycle " << pipe.cycle()
+                          << ": expected taken=" << expected_taken << " history=" << expected_history
+                          << ", got taken=" << static_cast<int>(dut->predict_taken)
+                          << " history=" << static_cast<uint32_t>(dut->predict_history) << std::endl;
+                return false;
+            }
+            if (!on_cycle(pipe.cycle()))
+            {
+                return false;
+            }
+
+            dut->clk = 1U;
+            dut->eval();
+            ctx->timeInc(1);
+            if (c.train_valid)
+            {
+                model.train(c.train_pc, c.train_history, c.train_taken);
+            }
+            model.update_history(c.train_valid && c.train_mispredicted, c.train_history, c.train_taken,
+                                 c.predict_valid, expected_taken);
+            pipe.end(expected_taken, expected_history);
+        }
+        stats = pipe.stats(sw.seconds());
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Verilated::commandArgs(argc, argv);
+    auto context = std::make_unique<VerilatedContext>();
+    context->commandArgs(argc, argv);
+    context->traceEverOn(false);
+
+    auto dut = std::make_unique<Vdut_171>(context.get());
+
+    // Trace: +trace=<file> or a synthetic +branches=<n> trace (default 50k),
+    // trained +latency=<n> cycles after prediction (default 4).
+    const tb::BranchTrace trace(context.get(), 50000U, 171U);
+    const unsigned latency = static_cast<unsigned>(
+        std::max<uint64_t>(1U, tb::plusarg_u64(context.get(), "latency", 4U)));
+    if (!trace.ok())
+    {
+        return EXIT_FAILURE;
+    }
+
+    GshareModel model(TB_PARAM_HIST_BITS, TB_PARAM_PHT_BITS);
+    tb::PredictorStats stats;
+#ifdef TB_REF
+    auto ref = std::make_unique<Vdut_162>(context.get());
+    apply_reset(ref.get());
+    auto lockstep = [&](uint64_t cycle) {
+        ref->predict_valid = dut->predict_valid;
+        ref->predict_pc = static_cast<uint8_t>(dut->predict_pc);
+        ref->train_valid = dut->train_valid;
+        ref->train_taken = dut->train_taken;
+        ref->train_mispredicted = dut->train_mispredicted;
+        ref->train_history = static_cast<uint8_t>(dut->train_history);
+        ref->train_pc = static_cast<uint8_t>(dut->train_pc);
+        ref->clk = 0U;
+        ref->eval();
+        if (ref->predict_taken != dut->predict_taken || ref->predict_history != dut->predict_history)
+        {
+            std::cerr << "[TB] dut_171 differs from dut_162 at cycle " << cycle << std::endl;
+            return false;
+        }
+        ref->clk = 1U;
+        ref->eval();
+        return true;
+    };
+#else
+    auto lockstep = [](uint64_t) { return true; };
+#endif
+    if (!replay_trace(dut.get(), context.get(), "dut_171", model, trace, latency, stats, lockstep))
+    {
+        return EXIT_FAILURE;
+    }
+    tb::report_predictor("dut_171", stats);
+
+#ifdef TB_SWEEP
+    auto jobs = tb::sweep_jobs<tb::PredictorStats>([&trace, latency](auto tag, const char *config) {
+        using Model = typename decltype(tag)::type;
+        const unsigned h = tb::sweep_param(config, "HIST_BITS", 7U);
+        const unsigned p = tb::sweep_param(config, "PHT_BITS", 7U);
+        return [&trace, latency, config, h, p](VerilatedContext *ctx, tb::PredictorStats &st) {
+            auto sweep_dut = std::make_unique<Model>(ctx);
+            GshareModel sweep_model(h, p);
+            return replay_trace(sweep_dut.get(), ctx, config, sweep_model, trace, latency, st,
+                                [](uint64_t) { return true; });
+        };
+    });
+    const tb::SweepRun sweep = tb::run_sweep(context.get(), jobs);
+
+    std::printf("[TB] dut_171 sweep: %zu branches, latency %u, %zu configurations on %u threads in %.2f s\n",
+                trace.size(), latency, jobs.size(), sweep.workers, sweep.seconds);
+    std::printf("[TB]   %-28s %9s %10s %10s %10s\n", "config", "entries", "PHT bytes", "MPKI", "Mbr/s");
+    for (const auto &j : jobs)
+    {
+        const unsigned long entries = 1UL << tb::sweep_param(j.config, "PHT_BITS", 7U);
+        std::printf("[TB]   %-28s %9lu %10lu %10.2f %10.2f%s\n", j.config, entries, entries / 4UL,
+                    j.stats.mpki(), j.stats.seconds > 0.0 ? double(j.stats.branches) / j.stats.seconds / 1e6 : 0.0,
+                    j.ok ? "" : "  FAILED");
+    }
+    std::fflush(stdout);
+    if (!sweep.ok)
+    {
+        return EXIT_FAILURE;
+    }
+#endif
+
+    std::cout << "[TB] dut_171 passed: gshare HIST_BITS=" << TB_PARAM_HIST_BITS
+              << " PHT_BITS=" << TB_PARAM_PHT_BITS << " trace replay" << std::endl;
+
+#if VM_COVERAGE
+    const char *covPath = std::getenv("VERILATOR_COV_FILE");
+    if (covPath == nullptr || covPath[0] == '\0')
+    {
+        covPath = "coverage.dat";
+    }
+    VerilatedCov::write(covPath);
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,475 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "verilated.h"
+#include "verilated_cov.h"
+#include "Vdut_172.h"
+#include "lib/tb_harness.h"
+
+// dut_172 is dut_150 at N requesters, fixed priority or round robin. Every
+// run drives a random request stream (below) checked cycle by cycle against
+// a width-generic model, plus three properties checked on their own:
+//   mutual exclusion   at most one grant bit set
+//   grant to request   every grant bit was requesting at the edge
+//   bounded wait       round robin: a waiting requester sees at most N-1
+//                      grants to others before its own
+// and reports per-requester fairness (max wait, Jain's index of the grant
+// counts).
+//
+//   +cycles=<n>      stream length (default 100000)
+//   +req_ppm=<p>     chance an idle requester raises its request per cycle
+//                    (default 300000, a sixteenth of it in alternate phases)
+//   +hold_max=<n>    cycles a granted requester keeps its request, 1..n
+//                    (default 4)
+//   +bench           time the model alone on the recorded stream
+//
+// Built with `make DUT=172 REF=150` (default parameters) the fixed dut_150
+// runs in lockstep and every grant must agree.
+//
+// Scaling benchmark: SWEEP builds dut_172 once per configuration, e.g.
+//   make DUT=172 TB_ARGS="+cycles=1000000 +threads=1" SWEEP="N=4 N=8 N=16 N=32 N=64
+//       N=4:ROUND_ROBIN=1 N=8:ROUND_ROBIN=1 N=16:ROUND_ROBIN=1 N=32:ROUND_ROBIN=1 N=64:ROUND_ROBIN=1"
+// Each configuration runs its checked stream and a model-only replay, and
+// the run ends with a table of grants/s and ns per cycle against N. Use
+// +threads=1 when the timings matter.
+#ifdef TB_REF
+#include "Vdut_150.h"
+#endif
+#ifdef TB_SWEEP
+#include "tb_sweep.h"
+#include "lib/sweep.h"
+#endif
+
+#ifndef TB_PARAM_N
+#define TB_PARAM_N 3
+#endif
+#ifndef TB_PARAM_ROUND_ROBIN
+#define TB_PARAM_ROUND_ROBIN 0
+#endif
+
+namespace
+{
+    inline uint64_t lowest_bit(uint64_t x) { return x & (~x + 1U); }
+
+    // Reference arbiter of any width, same pick and hold rules as dut_172.
+    struct ArbiterModel
+    {
+        unsigned n;
+        bool round_robin;
+        uint64_t state = 0U;    // grant, one-hot or 0
+        uint64_t last = 0U;     // last grant
+
+        ArbiterModel(unsigned width, bool rr) : n(width), round_robin(rr) {}
+
+        uint64_t mask() const { return n >= 64U ? ~uint64_t(0) : (uint64_t(1) << n) - 1U; }
+
+        uint64_t pick(uint64_t r) const
+        {
+            uint64_t pool = r;
+            if (round_robin)
+            {
+                const uint64_t above = ~((last << 1U) - 1U) & mask();
+                if ((r & above) != 0U)
+                {
+                    pool = r & above;
+                }
+            }
+            return lowest_bit(pool);
+        }
+
+        void step(uint64_t r)
+        {
+            state = state == 0U ? pick(r) : ((state & r) != 0U ? state : 0U);
+            if (state != 0U)
+            {
+                last = state;
+            }
+        }
+    };
+
+    // Closed-loop request stream: an idle requester raises its request with
+    // probability req_ppm per cycle and keeps it up until granted, then
+    // holds it 1..hold_max cycles under the grant and drops it. A requester
+    // does not re-request while its grant is still showing. Every
+    // kLoadPhase cycles the rate switches between req_ppm and req_ppm / 16,
+    // so picks from a nearly idle arbiter are exercised as well as
+    // contended ones.
+    class RequestStream
+    {
+    public:
+        RequestStream(unsigned n, uint64_t seed, uint64_t req_ppm, uint64_t hold_max)
+            : rng_(seed), hold_(n, 0U), req_ppm_(req_ppm), hold_max_(std::max<uint64_t>(1U, hold_max))
+        {
+        }
+
+        // Next cycle's requests given the grant after this cycle's edge.
+        uint64_t next(uint64_t g)
+        {
+            const uint64_t ppm = (cycle_++ / kLoadPhase) % 2U == 0U ? req_ppm_ : req_ppm_ / 16U;
+            for (unsigned i = 0; i < hold_.size(); ++i)
+            {
+                const uint64_t bit = uint64_t(1) << i;
+                if ((r_ & bit) != 0U)
+                {
+                    if ((g & bit) != 0U)
+                    {
+                        if (hold_[i] == 0U)
+                        {
+                            hold_[i] = static_cast<uint32_t>(1U + rng_() % hold_max_);
+                        }
+                        if (--hold_[i] == 0U)
+                        {
+                            r_ &= ~bit;
+                        }
+                    }
+                }
+                else if ((g & bit) == 0U && rng_() % 1000000U < ppm)
+                {
+                    r_ |= bit;
+                }
+            }
+            return r_;
+        }
+
+    private:
+        static constexpr uint64_t kLoadPhase = 8192U;
+
+        std::mt19937_64 rng_;
+        std::vector<uint32_t> hold_;
+        uint64_t req_ppm_;
+        uint64_t hold_max_;
+        uint64_t r_ = 0U;
+        uint64_t cycle_ = 0U;
+    };
+
+    struct StreamConfig
+    {
+        uint64_t cycles = 100000U;
+        uint64_t req_ppm = 300000U;
+        uint64_t hold_max = 4U;
+
+        static StreamConfig from_plusargs(VerilatedContext *ctx)
+        {
+            StreamConfig c;
+            c.cycles = tb::plusarg_u64(ctx, "cycles", c.cycles);
+            c.req_ppm = std::min<uint64_t>(1000000U, tb::plusarg_u64(ctx, "req_ppm", c.req_ppm));
+            c.hold_max = tb::plusarg_u64(ctx, "hold_max", c.hold_max);
+            return c;
+        }
+    };
+
+    struct ArbiterStats
+    {
+        uint64_t cycles = 0U;
+        uint64_t grants = 0U;           // new grants
+        uint64_t busy = 0U;             // cycles with a grant showing
+        uint64_t max_wait = 0U;         // grants to others seen by one waiting requester
+        std::vector<uint64_t> per_requester;
+        double seconds = 0.0;
+        double eval_seconds = 0.0;      // model-only replay, 0 when not run
+
+        double jain() const
+        {
+            double sum = 0.0, sq = 0.0;
+            for (uint64_t c : per_requester)
+            {
+                sum += double(c);
+                sq += double(c) * double(c);
+            }
+            return sq > 0.0 ? sum * sum / (double(per_requester.size()) * sq) : 0.0;
+        }
+    };
+
+    template <typename Model>
+    void apply_reset(Model *dut, VerilatedContext *ctx)
+    {
+        dut->resetn = 0U;
+        dut->r = 0U;
+        dut->clk = 0U;
+        dut->eval();
+        ctx->timeInc(1);
+        dut->clk = 1U;
+        dut->eval();
+        ctx->timeInc(1);
+        dut->resetn = 1U;
+    }
+
+    // One clock with requests r; returns the grant after the edge.
+    template <typename Model>
+    uint64_t clock(Model *dut, VerilatedContext *ctx, uint64_t r)
+    {
+        dut->r = r;
+        dut->clk = 0U;
+        dut->eval();
+        ctx->timeInc(1);
+        dut->clk = 1U;
+        dut->eval();
+        ctx->timeInc(1);
+        return uint64_t(dut->g);
+    }
+
+    // Runs the stream against the model and the property checks. The
+    // requests of every cycle go to `record` when given; `on_cycle` sees
+    // the DUT after each edge (for lockstep references) and may veto.
+    template <typename Model, typename OnCycle>
+    bool run_stream(Model *dut, VerilatedContext *ctx, const char *name, unsigned n, bool round_robin,
+                    const StreamConfig &cfg, uint64_t seed, ArbiterStats &st, std::vector<uint64_t> *record,
+                    OnCycle on_cycle)
+    {
+        ArbiterModel model(n, round_robin);
+        RequestStream stream(n, seed, cfg.req_ppm, cfg.hold_max);
+        std::vector<uint64_t> wait(n, 0U);
+        uint64_t waiting = 0U;          // requesters with wait != 0
+        st = ArbiterStats();
+        st.per_requester.assign(n, 0U);
+
+        apply_reset(dut, ctx);
+        if (dut->g != 0U)
+        {
+            std::cerr << "[TB] " << name << " grant not cleared by reset" << std::endl;
+            return false;
+        }
+        uint64_t g = 0U;
+        tb::Stopwatch sw;
+        for (uint64_t cycle = 0; cycle < cfg.cycles; ++cycle)
+        {
+            const uint64_t r = stream.next(g);
+            const uint64_t prev = g;
+            if (record != nullptr)
+            {
+                record->push_back(r);
+            }
+            g = clock(dut, ctx, r);
+            model.step(r);
+
+            const char *what = nullptr;
+            if ((g & (g - 1U)) != 0U)
+            {
+                what = "more than one grant";
+            }
+            else if ((g & ~r) != 0U)
+            {
+                what = "grant to a requester that was not requesting";
+            }
+            else if (g != model.state)
+            {
+                what = round_robin ? "grant differs from the round-robin model"
+                                   : "grant differs from the fixed-priority model";
+            }
+            if (what != nullptr)
+            {
+                std::cerr << "[TB] " << name << " failed at cycle " << cycle << ": " << what << " (r=0x"
+                          << std::hex << r << " previous g=0x" << prev << " expected g=0x" << model.state
+                          << " got g=0x" << g << std::dec << ")" << std::endl;
+                return false;
+            }
+            if (!on_cycle(cycle, g))
+            {
+                return false;
+            }
+
+            // Fairness: a new grant is one more grant to others for every
+            // requester left waiting at this edge.
+            for (uint64_t idle = waiting & ~r; idle != 0U; idle &= idle - 1U)
+            {
+                wait[__builtin_ctzll(idle)] = 0U;
+            }
+            waiting &= r;
+            if (g != 0U && prev == 0U)
+            {
+                const unsigned j = static_cast<unsigned>(__builtin_ctzll(g));
+                ++st.grants;
+                ++st.per_requester[j];
+                wait[j] = 0U;
+                waiting &= ~g;
+                for (uint64_t others = r & ~g; others != 0U; others &= others - 1U)
+                {
+                    const unsigned i = static_cast<unsigned>(__builtin_ctzll(others));
+                    st.max_wait = std::max(st.max_wait, ++wait[i]);
+                }
+                waiting |= r & ~g;
+                if (round_robin && st.max_wait > n - 1U)
+                {
+                    std::cerr << "[TB] " << name << " failed at cycle " << cycle << ": a requester waited "
+                              << st.max_wait << " grants (bound " << n - 1U << ")" << std::endl;
+                    return false;
+                }
+            }
+            st.busy += g != 0U ? 1U : 0U;
+        }
+        st.seconds = sw.seconds();
+        st.cycles = cfg.cycles;
+        return true;
+    }
+
+    // Model eval cost alone: the recorded requests replayed without the
+    // stream, the reference or the checks.
+    template <typename Model>
+    double time_evals(Model *dut, VerilatedContext *ctx, const std::vector<uint64_t> &record)
+    {
+        apply_reset(dut, ctx);
+        uint64_t sink = 0U;
+        tb::Stopwatch sw;
+        for (uint64_t r : record)
+        {
+            sink ^= clock(dut, ctx, r);
+        }
+        const double secs = sw.seconds();
+        volatile uint64_t keep = sink;
+        (void)keep;
+        return secs;
+    }
+
+    const char *mode_name(bool round_robin) { return round_robin ? "round robin" : "fixed priority"; }
+
+    void report_stream(const char *name, unsigned n, bool round_robin, const ArbiterStats &st)
+    {
+        const auto minmax = std::minmax_element(st.per_requester.begin(), st.per_requester.end());
+        tb::report_rate(name, "grants", double(st.grants), st.seconds, "grant");
+        std::cout << "[TB] " << name << " N=" << n << " " << mode_name(round_robin) << ": " << st.cycles
+                  << " cycles, " << st.grants << " grants, busy " << 100.0 * double(st.busy) / double(st.cycles)
+                  << "%, per requester " << *minmax.first << ".." << *minmax.second << " (Jain " << st.jain()
+                  << "), max wait " << st.max_wait << " grants" << std::endl;
+        if (st.eval_seconds > 0.0)
+        {
+            std::cout << "[TB] " << name << " model only: " << 1e9 * st.eval_seconds / double(st.cycles)
+                      << " ns/cycle, " << double(st.grants) / st.eval_seconds / 1e6 << " Mgrant/s" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Verilated::commandArgs(argc, argv);
+    auto context = std::make_unique<VerilatedContext>();
+    context->commandArgs(argc, argv);
+    context->traceEverOn(false);
+
+    auto dut = std::make_unique<Vdut_172>(context.get());
+    const unsigned n = TB_PARAM_N;
+    const bool round_robin = TB_PARAM_ROUND_ROBIN != 0;
+    const StreamConfig cfg = StreamConfig::from_plusargs(context.get());
+    const bool bench = tb::plusarg_flag(context.get(), "bench");
+
+    // Directed: a lone request is granted on the next edge and held while
+    // it stays up, and every requester gets its grant from idle.
+    ArbiterModel model(n, round_robin);
+    apply_reset(dut.get(), context.get());
+    for (unsigned i = 0; i < n; ++i)
+    {
+        const uint64_t bit = uint64_t(1) << i;
+        const uint64_t seq[] = {bit, bit, 0U, 0U};
+        for (uint64_t r : seq)
+        {
+            const uint64_t g = clock(dut.get(), context.get(), r);
+            model.step(r);
+            if (g != model.state)
+            {
+                std::cerr << "[TB] dut_172 failed (directed, requester " << i + 1U << "): r=0x" << std::hex
+                          << r << " expected g=0x" << model.state << " got g=0x" << g << std::dec << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+#ifdef TB_REF
+    static_assert(TB_PARAM_N == 3 && TB_PARAM_ROUND_ROBIN == 0, "REF=150 needs the default parameters");
+    auto ref = std::make_unique<Vdut_150>(context.get());
+    auto lockstep = [&](uint64_t cycle, uint64_t g) {
+        ref->resetn = dut->resetn;
+        ref->r = dut->r;
+        ref->clk = 0U;
+        ref->eval();
+        ref->clk = 1U;
+        ref->eval();
+        if (ref->g != g)
+        {
+            std::cerr << "[TB] dut_172 differs from dut_150 at cycle " << cycle << std::endl;
+            return false;
+        }
+        return true;
+    };
+    ref->resetn = 0U;
+    ref->r = 0U;
+    ref->clk = 0U;
+    ref->eval();
+    ref->clk = 1U;
+    ref->eval();
+#else
+    auto lockstep = [](uint64_t, uint64_t) { return true; };
+#endif
+
+    ArbiterStats stats;
+    std::vector<uint64_t> record;
+    if (!run_stream(dut.get(), context.get(), "dut_172", n, round_robin, cfg, 172U, stats,
+                    bench ? &record : nullptr, lockstep))
+    {
+        return EXIT_FAILURE;
+    }
+    if (bench)
+    {
+        stats.eval_seconds = time_evals(dut.get(), context.get(), record);
+    }
+    report_stream("dut_172", n, round_robin, stats);
+
+#ifdef TB_SWEEP
+    auto jobs = tb::sweep_jobs<ArbiterStats>([&cfg](auto tag, const char *config) {
+        using Model = typename decltype(tag)::type;
+        const unsigned jn = tb::sweep_param(config, "N", 3U);
+        const bool rr = tb::sweep_param(config, "ROUND_ROBIN", 0U) != 0U;
+        return [&cfg, config, jn, rr](VerilatedContext *ctx, ArbiterStats &st) {
+            auto sweep_dut = std::make_unique<Model>(ctx);
+            std::vector<uint64_t> sweep_record;
+            sweep_record.reserve(cfg.cycles);
+            if (!run_stream(sweep_dut.get(), ctx, config, jn, rr, cfg, 172U, st, &sweep_record,
+                            [](uint64_t, uint64_t) { return true; }))
+            {
+                return false;
+            }
+            st.eval_seconds = time_evals(sweep_dut.get(), ctx, sweep_record);
+            return true;
+        };
+    });
+    const tb::SweepRun sweep = tb::run_sweep(context.get(), jobs);
+
+    std::printf("[TB] dut_172 sweep: %llu cycles, req_ppm %llu, hold_max %llu, %zu configurations on %u threads "
+                "in %.2f s\n",
+                static_cast<unsigned long long>(cfg.cycles), static_cast<unsigned long long>(cfg.req_ppm),
+                static_cast<unsigned long long>(cfg.hold_max), jobs.size(), sweep.workers, sweep.seconds);
+    std::printf("[TB]   %-20s %4s %-14s %8s %6s %10s %10s %10s\n", "config", "N", "mode", "max wait", "Jain",
+                "Mgrant/s", "ns/cycle", "model Mg/s");
+    for (const auto &j : jobs)
+    {
+        const ArbiterStats &s = j.stats;
+        std::printf("[TB]   %-20s %4u %-14s %8llu %6.3f %10.2f %10.2f %10.2f%s\n", j.config,
+                    tb::sweep_param(j.config, "N", 3U), mode_name(tb::sweep_param(j.config, "ROUND_ROBIN", 0U) != 0U), static_cast<unsigned long long>(s.max_wait), s.jain(),
+                    s.seconds > 0.0 ? double(s.grants) / s.seconds / 1e6 : 0.0,
+                    s.cycles != 0U ? 1e9 * s.eval_seconds / double(s.cycles) : 0.0,
+                    s.eval_seconds > 0.0 ? double(s.grants) / s.eval_seconds / 1e6 : 0.0, j.ok ? "" : "  FAILED");
+    }
+    std::fflush(stdout);
+    if (!sweep.ok)
+    {
+        return EXIT_FAILURE;
+    }
+#endif
+
+    std::cout << "[TB] dut_172 passed: N=" << n << " " << mode_name(round_robin)
+              << " arbiter, one-hot grants match the model" << std::endl;
+
+#if VM_COVERAGE
+    const char *covPath = std::getenv("VERILATOR_COV_FILE");
+    if (covPath == nullptr || covPath[0] == '\0')
+    {
+        covPath = "coverage.dat";
+    }
+    VerilatedCov::write(covPath);
+#endif
+    return EXIT_SUCCESS;
+}